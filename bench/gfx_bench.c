@@ -0,0 +1,132 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "pico/stdlib.h"
+#include "ssd1306.h"
+#include "ssd1306_gfx.h"
+
+// Microbenchmark (no computador) das primitivas de ssd1306_gfx contra as funções pixel a pixel do driver.
+// Cada caso desenha a mesma figura pelos dois caminhos, confere que os buffers ficaram iguais e imprime
+// uma linha CSV: caso,ns_driver,ns_gfx,aceleracao,confere
+
+#define BENCH_ITERATIONS 20000
+
+typedef void (*bench_draw_t)(uint8_t *ssd);
+
+static uint8_t bench_reference[ssd1306_buffer_length];
+static uint8_t bench_result[ssd1306_buffer_length] __attribute__((aligned(4)));
+
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static double bench_time(bench_draw_t draw, uint8_t *ssd) {
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        draw(ssd);
+        __asm__ volatile("" ::: "memory"); // Impede que o compilador junte as iterações
+    }
+    return (double)(bench_now_ns() - start) / BENCH_ITERATIONS;
+}
+
+// --- Caminho atual (ssd1306_set_pixel / ssd1306_draw_line) ---
+
+static void driver_clear(uint8_t *ssd) {
+    for (int y = 0; y < ssd1306_height; y++) {
+        for (int x = 0; x < ssd1306_width; x++) {
+            ssd1306_set_pixel(ssd, x, y, false);
+        }
+    }
+}
+
+// Barra de progresso de 100x10 pixels começando fora do limite de página (y = 50)
+static void driver_fill_rect(uint8_t *ssd) {
+    for (int y = 50; y < 60; y++) {
+        for (int x = 10; x < 110; x++) {
+            ssd1306_set_pixel(ssd, x, y, true);
+        }
+    }
+}
+
+static void driver_rect(uint8_t *ssd) {
+    ssd1306_draw_line(ssd, 2, 3, 125, 3, true);
+    ssd1306_draw_line(ssd, 2, 60, 125, 60, true);
+    ssd1306_draw_line(ssd, 2, 4, 2, 59, true);
+    ssd1306_draw_line(ssd, 125, 4, 125, 59, true);
+}
+
+static void driver_invert_rect(uint8_t *ssd) {
+    for (int y = 20; y < 37; y++) {
+        for (int x = 5; x < 121; x++) {
+            bool on = (ssd[(y / 8) * ssd1306_width + x] >> (y % 8)) & 1;
+            ssd1306_set_pixel(ssd, x, y, !on);
+        }
+    }
+}
+
+static void driver_lines(uint8_t *ssd) {
+    ssd1306_draw_line(ssd, 0, 0, 127, 63, true);
+    ssd1306_draw_line(ssd, 0, 63, 127, 0, true);
+    ssd1306_draw_line(ssd, 64, 0, 10, 63, true);
+}
+
+// --- ssd1306_gfx ---
+
+static void gfx_clear(uint8_t *ssd) {
+    ssd1306_gfx_clear(ssd, ssd1306_width, ssd1306_height, false);
+}
+
+static void gfx_fill_rect(uint8_t *ssd) {
+    ssd1306_gfx_fill_rect(ssd, ssd1306_width, ssd1306_height, 10, 50, 100, 10, SSD1306_GFX_SET);
+}
+
+static void gfx_rect(uint8_t *ssd) {
+    ssd1306_gfx_rect(ssd, ssd1306_width, ssd1306_height, 2, 3, 124, 58, SSD1306_GFX_SET);
+}
+
+static void gfx_invert_rect(uint8_t *ssd) {
+    ssd1306_gfx_invert_rect(ssd, ssd1306_width, ssd1306_height, 5, 20, 116, 17);
+}
+
+static void gfx_lines(uint8_t *ssd) {
+    ssd1306_gfx_line(ssd, ssd1306_width, ssd1306_height, 0, 0, 127, 63, SSD1306_GFX_SET);
+    ssd1306_gfx_line(ssd, ssd1306_width, ssd1306_height, 0, 63, 127, 0, SSD1306_GFX_SET);
+    ssd1306_gfx_line(ssd, ssd1306_width, ssd1306_height, 64, 0, 10, 63, SSD1306_GFX_SET);
+}
+
+static const struct {
+    const char *name;
+    bench_draw_t driver;
+    bench_draw_t gfx;
+} bench_cases[] = {
+    {"clear", driver_clear, gfx_clear},
+    {"fill_rect", driver_fill_rect, gfx_fill_rect},
+    {"rect", driver_rect, gfx_rect},
+    {"invert_rect", driver_invert_rect, gfx_invert_rect},
+    {"lines", driver_lines, gfx_lines},
+};
+
+int main(void) {
+    int failures = 0;
+
+    printf("caso,ns_driver,ns_gfx,aceleracao,confere\n");
+
+    for (size_t i = 0; i < count_of(bench_cases); i++) {
+        // Conferência: uma aplicação de cada caminho sobre o mesmo fundo (um padrão, para a inversão)
+        memset(bench_reference, 0x5A, ssd1306_buffer_length);
+        memset(bench_result, 0x5A, ssd1306_buffer_length);
+        bench_cases[i].driver(bench_reference);
+        bench_cases[i].gfx(bench_result);
+        bool same = memcmp(bench_reference, bench_result, ssd1306_buffer_length) == 0;
+
+        double driver_ns = bench_time(bench_cases[i].driver, bench_reference);
+        double gfx_ns = bench_time(bench_cases[i].gfx, bench_result);
+
+        printf("%s,%.1f,%.1f,%.1f,%s\n", bench_cases[i].name, driver_ns, gfx_ns, driver_ns / gfx_ns, same ? "ok" : "DIFERENTE");
+        failures += !same;
+    }
+
+    return failures != 0;
+}
@@ -0,0 +1,315 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pico/stdlib.h"
+#include "ssd1306.h"
+#include "ssd1306_gfx.h"
+#include "hal_host.h"
+
+// Microbenchmark (no computador) dos caminhos de desenho e envio do driver, com o I2C e o DMA substituídos
+// pelos de host/. Imprime uma linha CSV por caso: caso,ns_op,custo,bytes_quadro,transacoes_quadro
+// (as duas últimas colunas só nos casos que enviam quadros; nos demais ficam em zero). O custo é o tempo do
+// caso dividido pelo do ssd1306_set_pixel original (set_pixel_original), medido na mesma execução: ele não
+// depende da velocidade da máquina, ao contrário de ns_op, que é só informativo.
+//
+// Com um arquivo de referência no mesmo formato (./render_bench referencia.csv), cada caso é comparado:
+// bytes e transações por quadro não podem aumentar, e o custo não pode passar de BENCH_COST_TOLERANCE vezes
+// o da referência (linhas com custo 0 só conferem o barramento). Alguma regressão faz o programa retornar 1
+
+#define BENCH_ITERATIONS    20000
+#define BENCH_FRAMES        2000
+#define BENCH_REPEATS       7
+#define BENCH_COST_TOLERANCE 1.5
+#define BENCH_MAX_CASES     16
+
+typedef struct {
+    char name[32];
+    double ns_per_op;
+    double cost;                        // ns_per_op em unidades do set_pixel original
+    double bytes_per_frame;
+    double transactions_per_frame;
+} bench_result_t;
+
+static bench_result_t bench_results[BENCH_MAX_CASES];
+static int bench_count = 0;
+
+static uint8_t bench_frame[ssd1306_buffer_length] __attribute__((aligned(4)));
+static volatile int bench_sink;     // Impede que o compilador descarte resultados não usados
+
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// Cada caso executa ops operações e retorna o tempo gasto; os casos que enviam quadros preenchem bus
+typedef uint64_t (*bench_case_t)(ssd1306_bus_stats_t *bus);
+
+// --- Unidade de custo ---
+
+// ssd1306_set_pixel como era antes das otimizações do driver, congelado aqui para servir de unidade de tempo.
+// É chamado por um ponteiro volátil, como o do driver é chamado de outro arquivo, para não ser embutido
+static void bench_original_set_pixel(uint8_t *ssd, int x, int y, bool set) {
+    assert(x >= 0 && x < ssd1306_width && y >= 0 && y < ssd1306_height);
+
+    const int bytes_per_row = ssd1306_width;
+
+    int byte_idx = (y / 8) * bytes_per_row + x;
+    uint8_t byte = ssd[byte_idx];
+
+    if (set) {
+        byte |= 1 << (y % 8);
+    }
+    else {
+        byte &= ~(1 << (y % 8));
+    }
+
+    ssd[byte_idx] = byte;
+}
+
+static void (*volatile bench_original)(uint8_t *ssd, int x, int y, bool set) = bench_original_set_pixel;
+
+static uint64_t bench_set_pixel_original(ssd1306_bus_stats_t *bus) {
+    void (*set_pixel)(uint8_t *ssd, int x, int y, bool set) = bench_original;
+
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        set_pixel(bench_frame, i & 127, (i >> 7) & 63, i & 1);
+        __asm__ volatile("" ::: "memory");
+    }
+    return bench_now_ns() - start;
+}
+
+// --- Primitivas ---
+
+static uint64_t bench_set_pixel(ssd1306_bus_stats_t *bus) {
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        ssd1306_set_pixel(bench_frame, i & 127, (i >> 7) & 63, i & 1);
+        __asm__ volatile("" ::: "memory");
+    }
+    return bench_now_ns() - start;
+}
+
+static uint64_t bench_draw_line(ssd1306_bus_stats_t *bus) {
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        ssd1306_draw_line(bench_frame, 0, 0, 127, 63, true);
+        __asm__ volatile("" ::: "memory");
+    }
+    return bench_now_ns() - start;
+}
+
+// Caractere alinhado à página (uma página por coluna)
+static uint64_t bench_draw_char(ssd1306_bus_stats_t *bus) {
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        ssd1306_draw_char(bench_frame, 40, 16, 'A' + (i % 26));
+        __asm__ volatile("" ::: "memory");
+    }
+    return bench_now_ns() - start;
+}
+
+// Caractere desalinhado (duas páginas por coluna)
+static uint64_t bench_draw_char_unaligned(ssd1306_bus_stats_t *bus) {
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        ssd1306_draw_char(bench_frame, 40, 19, 'A' + (i % 26));
+        __asm__ volatile("" ::: "memory");
+    }
+    return bench_now_ns() - start;
+}
+
+static uint64_t bench_draw_string(ssd1306_bus_stats_t *bus) {
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        ssd1306_draw_string(bench_frame, 5, 32, "Acertos: 42");
+        __asm__ volatile("" ::: "memory");
+    }
+    return bench_now_ns() - start;
+}
+
+static uint64_t bench_render_area_length(ssd1306_bus_stats_t *bus) {
+    struct render_area area = {.start_column = 0, .end_column = ssd1306_width - 1, .start_page = 0};
+    int total = 0;
+
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        area.end_page = i & 7;
+        calculate_render_area_buffer_length(&area);
+        total += area.buffer_length;
+        __asm__ volatile("" ::: "memory");
+    }
+    bench_sink = total;
+    return bench_now_ns() - start;
+}
+
+// --- Quadros completos (desenho e envio) ---
+
+// Mesmo quadro de display_two_messages (src/main.c): tela limpa, duas linhas de texto e flip
+static void bench_compose_two_messages(int seconds, int score) {
+    char line1[32], line2[32];
+    uint8_t *ssd = ssd1306_back_buffer();
+
+    snprintf(line1, sizeof(line1), "Tempo: %02d", seconds);
+    snprintf(line2, sizeof(line2), "Acertos: %d", score);
+    ssd1306_gfx_clear(ssd, ssd1306_width, ssd1306_height, false);
+    ssd1306_draw_string(ssd, 5, 2 * 8, line1);
+    ssd1306_draw_string(ssd, 5, 4 * 8, line2);
+    ssd1306_flip();
+}
+
+// Contagem regressiva: só os dígitos do tempo mudam a cada quadro
+static uint64_t bench_two_messages_countdown(ssd1306_bus_stats_t *bus) {
+    bench_compose_two_messages(60, 7);  // Quadro inicial fora da medida
+    ssd1306_wait_transfer(portMAX_DELAY);
+    ssd1306_reset_bus_stats();
+
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < BENCH_FRAMES; i++) {
+        bench_compose_two_messages(59 - (i % 60), 7);
+    }
+    ssd1306_wait_transfer(portMAX_DELAY);
+    uint64_t elapsed = bench_now_ns() - start;
+
+    ssd1306_get_bus_stats(bus);
+    return elapsed;
+}
+
+// Quadro idêntico ao anterior: o flip não deve enviar nada
+static uint64_t bench_two_messages_unchanged(ssd1306_bus_stats_t *bus) {
+    bench_compose_two_messages(30, 7);
+    ssd1306_wait_transfer(portMAX_DELAY);
+    ssd1306_reset_bus_stats();
+
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < BENCH_FRAMES; i++) {
+        bench_compose_two_messages(30, 7);
+    }
+    ssd1306_wait_transfer(portMAX_DELAY);
+    uint64_t elapsed = bench_now_ns() - start;
+
+    ssd1306_get_bus_stats(bus);
+    return elapsed;
+}
+
+// Tela inteira enviada com render_on_display, como antes do envio por diferença
+static uint64_t bench_full_frame(ssd1306_bus_stats_t *bus) {
+    struct render_area frame_area = {
+        .start_column = 0,
+        .end_column = ssd1306_width - 1,
+        .start_page = 0,
+        .end_page = ssd1306_n_pages - 1
+    };
+
+    calculate_render_area_buffer_length(&frame_area);
+    memset(bench_frame, 0x5A, ssd1306_buffer_length);
+    ssd1306_reset_bus_stats();
+
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < BENCH_FRAMES; i++) {
+        render_on_display(bench_frame, &frame_area);
+    }
+    ssd1306_wait_transfer(portMAX_DELAY);
+    uint64_t elapsed = bench_now_ns() - start;
+
+    ssd1306_get_bus_stats(bus);
+    return elapsed;
+}
+
+static const struct {
+    const char *name;
+    bench_case_t run;
+    int ops;                            // Operações por execução
+    bool frames;                        // As operações são quadros enviados ao display
+} bench_cases[] = {
+    {"set_pixel_original", bench_set_pixel_original, BENCH_ITERATIONS, false},  // Unidade de custo: o primeiro
+    {"set_pixel", bench_set_pixel, BENCH_ITERATIONS, false},
+    {"draw_line", bench_draw_line, BENCH_ITERATIONS, false},
+    {"draw_char", bench_draw_char, BENCH_ITERATIONS, false},
+    {"draw_char_unaligned", bench_draw_char_unaligned, BENCH_ITERATIONS, false},
+    {"draw_string", bench_draw_string, BENCH_ITERATIONS, false},
+    {"render_area_length", bench_render_area_length, BENCH_ITERATIONS, false},
+    {"two_messages_countdown", bench_two_messages_countdown, BENCH_FRAMES, true},
+    {"two_messages_unchanged", bench_two_messages_unchanged, BENCH_FRAMES, true},
+    {"full_frame", bench_full_frame, BENCH_FRAMES, true},
+};
+
+// Executa o caso BENCH_REPEATS vezes e fica com o menor tempo (o menos perturbado pelo sistema)
+static void bench_run(int index) {
+    bench_result_t *result = &bench_results[bench_count++];
+    ssd1306_bus_stats_t bus = {0, 0};
+    uint64_t best_ns = UINT64_MAX;
+
+    for (int repeat = 0; repeat < BENCH_REPEATS; repeat++) {
+        uint64_t elapsed = bench_cases[index].run(&bus);
+        if (elapsed < best_ns) {
+            best_ns = elapsed;
+        }
+    }
+
+    int ops = bench_cases[index].ops;
+    snprintf(result->name, sizeof(result->name), "%s", bench_cases[index].name);
+    result->ns_per_op = (double)best_ns / ops;
+    result->cost = result->ns_per_op / bench_results[0].ns_per_op;
+    result->bytes_per_frame = bench_cases[index].frames ? (double)bus.bytes / ops : 0;
+    result->transactions_per_frame = bench_cases[index].frames ? (double)bus.transactions / ops : 0;
+    printf("%s,%.1f,%.2f,%.1f,%.2f\n", result->name, result->ns_per_op, result->cost, result->bytes_per_frame,
+           result->transactions_per_frame);
+}
+
+// --- Comparação com a referência ---
+
+static int bench_compare(const char *path) {
+    FILE *file = fopen(path, "r");
+    char line[128];
+    int regressions = 0;
+
+    if (file == NULL) {
+        fprintf(stderr, "render_bench: não foi possível abrir %s\n", path);
+        return 1;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        char name[32];
+        double ns, cost, bytes, transactions;
+
+        if (sscanf(line, "%31[^,],%lf,%lf,%lf,%lf", name, &ns, &cost, &bytes, &transactions) != 5) {
+            continue; // Cabeçalho ou linha em branco
+        }
+
+        for (int i = 0; i < bench_count; i++) {
+            const bench_result_t *result = &bench_results[i];
+
+            if (strcmp(result->name, name) != 0) {
+                continue;
+            }
+            if (result->bytes_per_frame > bytes + 0.05 || result->transactions_per_frame > transactions + 0.005) {
+                fprintf(stderr, "regressao,%s,barramento,%.1f bytes %.2f transacoes (referencia %.1f %.2f)\n", name,
+                        result->bytes_per_frame, result->transactions_per_frame, bytes, transactions);
+                regressions++;
+            }
+            if (cost > 0 && result->cost > cost * BENCH_COST_TOLERANCE) {
+                fprintf(stderr, "regressao,%s,cpu,custo %.2f (referencia %.2f)\n", name, result->cost, cost);
+                regressions++;
+            }
+        }
+    }
+
+    fclose(file);
+    return regressions != 0;
+}
+
+int main(int argc, char **argv) {
+    hal_host_set_i2c_recording(false);  // Mede o driver, não a escrita do registro
+    ssd1306_init();
+
+    printf("caso,ns_op,custo,bytes_quadro,transacoes_quadro\n");
+
+    for (size_t i = 0; i < count_of(bench_cases); i++) {
+        bench_run(i);
+    }
+
+    return argc > 1 ? bench_compare(argv[1]) : 0;
+}
@@ -0,0 +1,143 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "audio_dma.h"
+#include "audio_tables.h"
+#include "hal_host.h"
+
+// Substituto do transporte de áudio para a compilação no host: uma tarefa pede um bloco de cada saída a cada
+// período de bloco, como faria a tarefa do áudio acordada pelo DMA. Como no hardware, o silêncio em todas as
+// saídas desce até o nível 0 e para o transporte (o arquivo recebe zeros, sem chamar o sintetizador) até
+// audio_dma_start, que volta com uma rampa até o centro. O início e o fim de cada som vão para o registro
+// (hal_host_record_audio) e, com REFLEX_AUDIO, as amostras vão para um arquivo de 8 bits sem sinal com as
+// saídas intercaladas (aplay -f U8 -c 2 -r 32000 arquivo)
+
+static uint audio_dma_host_pins[AUDIO_MAX_OUTPUTS];
+static uint audio_dma_host_count = 0;
+static uint32_t audio_dma_host_rate = 0;
+static audio_dma_fill_t audio_dma_host_fill = NULL;
+static FILE *audio_dma_host_file = NULL;
+static volatile bool audio_dma_host_start = false;     // Pedido de audio_dma_start ainda não atendido
+
+// Maior distância de uma amostra até o nível central (o silêncio)
+static uint audio_dma_host_peak(const uint16_t *block, uint count) {
+    uint peak = 0;
+
+    for (uint i = 0; i < count; i++) {
+        uint distance = block[i] > AUDIO_CENTER_LEVEL ? block[i] - AUDIO_CENTER_LEVEL : AUDIO_CENTER_LEVEL - block[i];
+
+        if (distance > peak) {
+            peak = distance;
+        }
+    }
+    return peak;
+}
+
+// Soma ao bloco uma rampa linear que desloca a primeira amostra de from e a última de exatamente to
+static void audio_dma_host_ramp(uint16_t *block, int from, int to) {
+    for (uint i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+        int32_t sample = block[i] + from + (to - from) * (int)(i + 1) / AUDIO_BLOCK_SAMPLES;
+
+        block[i] = sample < 0 ? 0 : sample > AUDIO_PWM_WRAP ? AUDIO_PWM_WRAP : (uint16_t)sample;
+    }
+}
+
+static void audio_dma_host_task(void *params) {
+    static uint16_t blocks[AUDIO_MAX_OUTPUTS][AUDIO_BLOCK_SAMPLES];
+    static uint8_t frames[AUDIO_BLOCK_SAMPLES * AUDIO_MAX_OUTPUTS];
+    bool sounding[AUDIO_MAX_OUTPUTS] = {false};
+    bool running = false;
+    bool ramp_up = false;
+    uint quiet = 0;
+    TickType_t period = pdMS_TO_TICKS(AUDIO_BLOCK_SAMPLES * 1000 / audio_dma_host_rate);
+    TickType_t wake = xTaskGetTickCount();
+
+    for (;;) {
+        vTaskDelayUntil(&wake, period > 0 ? period : 1);
+
+        if (!running) {
+            if (!audio_dma_host_start) {
+                if (audio_dma_host_file != NULL) {
+                    memset(frames, 0, sizeof(frames));
+                    fwrite(frames, audio_dma_host_count, AUDIO_BLOCK_SAMPLES, audio_dma_host_file);
+                }
+                continue;
+            }
+            audio_dma_host_start = false;
+            running = true;
+            ramp_up = true;
+            quiet = 0;
+        }
+
+        bool any = false;
+
+        for (uint o = 0; o < audio_dma_host_count; o++) {
+            bool sound = audio_dma_host_fill(o, blocks[o], AUDIO_BLOCK_SAMPLES);
+
+            any = any || sound;
+            if (sound != sounding[o]) {
+                uint peak = sound ? audio_dma_host_peak(blocks[o], AUDIO_BLOCK_SAMPLES) : 0;
+
+                sounding[o] = sound;
+                hal_host_record_audio(audio_dma_host_pins[o], peak);
+            }
+            if (ramp_up) {
+                audio_dma_host_ramp(blocks[o], -AUDIO_CENTER_LEVEL, 0);
+            }
+        }
+        ramp_up = false;
+
+        // Dois blocos seguidos de silêncio em todas as saídas: este desce até o nível 0 e o transporte para
+        quiet = any ? 0 : quiet + 1;
+        if (quiet >= 2) {
+            for (uint o = 0; o < audio_dma_host_count; o++) {
+                audio_dma_host_ramp(blocks[o], 0, -AUDIO_CENTER_LEVEL);
+            }
+            running = false;
+        }
+
+        for (uint o = 0; o < audio_dma_host_count; o++) {
+            for (uint i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+                frames[i * audio_dma_host_count + o] = (uint8_t)blocks[o][i];
+            }
+        }
+
+        if (audio_dma_host_file != NULL) {
+            fwrite(frames, audio_dma_host_count, AUDIO_BLOCK_SAMPLES, audio_dma_host_file);
+        }
+    }
+}
+
+void audio_dma_init(const uint *pins, uint count, uint32_t sample_rate, audio_dma_fill_t fill, UBaseType_t core_mask) {
+    const char *path = getenv("REFLEX_AUDIO");
+
+    (void)core_mask;
+    assert(count <= AUDIO_MAX_OUTPUTS);
+    for (uint o = 0; o < count; o++) {
+        audio_dma_host_pins[o] = pins[o];
+        gpio_set_function(pins[o], GPIO_FUNC_PWM);
+    }
+    audio_dma_host_count = count;
+    audio_dma_host_rate = sample_rate;
+    audio_dma_host_fill = fill;
+
+    if (path != NULL) {
+        audio_dma_host_file = fopen(path, "wb");
+    }
+
+#if configSUPPORT_STATIC_ALLOCATION
+    static StackType_t stack[configMINIMAL_STACK_SIZE * 2];
+    static StaticTask_t tcb;
+    xTaskCreateStatic(audio_dma_host_task, "HAL Audio", configMINIMAL_STACK_SIZE * 2, NULL, configMAX_PRIORITIES - 2, stack, &tcb);
+#else
+    xTaskCreate(audio_dma_host_task, "HAL Audio", configMINIMAL_STACK_SIZE * 2, NULL, configMAX_PRIORITIES - 2, NULL);
+#endif
+}
+
+void audio_dma_start(void) {
+    audio_dma_host_start = true;
+}
@@ -0,0 +1,315 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pico/stdlib.h"
+#include "pico/rand.h"
+#include "hardware/gpio.h"
+#include "hardware/pwm.h"
+#include "hardware/i2c.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "hal_host.h"
+
+#define HAL_HOST_NUM_GPIOS          30
+#define HAL_HOST_MAX_SCRIPT_EVENTS  4096
+
+// Evento do roteiro de botões; gpio < 0 encerra o programa
+typedef struct {
+    uint32_t time_ms;
+    int gpio;
+    bool level;
+} hal_host_script_event_t;
+
+i2c_inst_t i2c0_inst = {0, 0};
+i2c_inst_t i2c1_inst = {1, 0};
+
+static FILE *hal_host_trace = NULL;
+static uint32_t hal_host_rand_state = 1;
+static bool hal_host_i2c_recording = true;
+
+static bool hal_host_gpio_level[HAL_HOST_NUM_GPIOS];
+static bool hal_host_gpio_out[HAL_HOST_NUM_GPIOS];
+static enum gpio_function hal_host_gpio_function[HAL_HOST_NUM_GPIOS];
+static uint32_t hal_host_gpio_irq_mask[HAL_HOST_NUM_GPIOS];
+static gpio_irq_callback_t hal_host_gpio_callback = NULL;
+
+static uint16_t hal_host_pwm_wrap[8];
+
+static hal_host_script_event_t hal_host_script[HAL_HOST_MAX_SCRIPT_EVENTS];
+static uint hal_host_script_length = 0;
+static bool hal_host_script_started = false;
+
+// --- Relógio ---
+
+uint64_t time_us_64(void) {
+    static uint64_t boot_us = 0;
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    uint64_t us = (uint64_t)now.tv_sec * 1000000u + (uint64_t)now.tv_nsec / 1000u;
+
+    if (boot_us == 0) {
+        boot_us = us;
+    }
+    return us - boot_us;
+}
+
+// --- Registro das saídas ---
+
+static FILE *hal_host_trace_file(void) {
+    if (hal_host_trace == NULL) {
+        const char *path = getenv("REFLEX_HOST_LOG");
+
+        hal_host_trace = path != NULL ? fopen(path, "w") : NULL;
+        if (hal_host_trace == NULL) {
+            hal_host_trace = stderr;
+        }
+    }
+    return hal_host_trace;
+}
+
+void hal_host_set_i2c_recording(bool enabled) {
+    hal_host_i2c_recording = enabled;
+}
+
+void hal_host_record_i2c(i2c_inst_t *i2c, uint8_t address, const uint8_t *data, size_t length) {
+    if (!hal_host_i2c_recording) {
+        return;
+    }
+
+    FILE *trace = hal_host_trace_file();
+
+    fprintf(trace, "%llu I2C%u 0x%02x %zu", (unsigned long long)time_us_64(), i2c->index, address, length);
+    for (size_t i = 0; i < length; i++) {
+        fprintf(trace, " %02x", data[i]);
+    }
+    fputc('\n', trace);
+}
+
+void hal_host_record_audio(uint gpio, uint peak) {
+    fprintf(hal_host_trace_file(), "%llu AUDIO %u %u\n", (unsigned long long)time_us_64(), gpio, peak);
+}
+
+// --- Inicialização e números aleatórios ---
+
+bool stdio_init_all(void) {
+    const char *seed = getenv("REFLEX_SEED");
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    hal_host_rand_state = seed != NULL ? (uint32_t)strtoul(seed, NULL, 0) : 1;
+    if (hal_host_rand_state == 0) {
+        hal_host_rand_state = 1;
+    }
+    fprintf(hal_host_trace_file(), "0 SEED %lu\n", (unsigned long)hal_host_rand_state);
+    return true;
+}
+
+void panic(const char *fmt, ...) {
+    va_list args;
+
+    fflush(stdout);
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    va_end(args);
+    fputc('\n', stderr);
+    abort();
+}
+
+// xorshift32: sequência determinística para reproduzir partidas
+uint32_t get_rand_32(void) {
+    uint32_t x = hal_host_rand_state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    hal_host_rand_state = x;
+    return x;
+}
+
+// --- Roteiro de botões ---
+
+static void hal_host_load_script(void) {
+    const char *path = getenv("REFLEX_INPUT");
+    char line[128];
+
+    if (path == NULL) {
+        return;
+    }
+
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "hal_host: nao foi possivel abrir %s\n", path);
+        return;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL && hal_host_script_length < HAL_HOST_MAX_SCRIPT_EVENTS) {
+        hal_host_script_event_t *event = &hal_host_script[hal_host_script_length];
+        unsigned long time_ms;
+        int gpio, level;
+        char word[16];
+
+        if (line[0] == '#') {
+            continue;
+        }
+        if (sscanf(line, "%lu %d %d", &time_ms, &gpio, &level) == 3 && gpio >= 0 && gpio < HAL_HOST_NUM_GPIOS) {
+            event->time_ms = time_ms;
+            event->gpio = gpio;
+            event->level = level != 0;
+            hal_host_script_length++;
+        }
+        else if (sscanf(line, "%lu %15s", &time_ms, word) == 2 && strcmp(word, "exit") == 0) {
+            event->time_ms = time_ms;
+            event->gpio = -1;
+            hal_host_script_length++;
+        }
+    }
+
+    fclose(file);
+}
+
+// Aplica um nível de entrada e dispara o callback de GPIO como faria a interrupção
+static void hal_host_drive_input(uint gpio, bool level) {
+    bool previous = hal_host_gpio_level[gpio];
+    uint32_t events = 0;
+
+    hal_host_gpio_level[gpio] = level;
+    if (previous && !level) {
+        events = GPIO_IRQ_EDGE_FALL;
+    }
+    else if (!previous && level) {
+        events = GPIO_IRQ_EDGE_RISE;
+    }
+
+    events &= hal_host_gpio_irq_mask[gpio];
+    if (events != 0 && hal_host_gpio_callback != NULL) {
+        hal_host_gpio_callback(gpio, events);
+    }
+}
+
+// Tarefa que reproduz o roteiro nos instantes indicados (faz o papel das interrupções de GPIO)
+static void hal_host_script_task(void *params) {
+    for (uint i = 0; i < hal_host_script_length; i++) {
+        const hal_host_script_event_t *event = &hal_host_script[i];
+        uint32_t now_ms = to_ms_since_boot(get_absolute_time());
+
+        if (event->time_ms > now_ms) {
+            vTaskDelay(pdMS_TO_TICKS(event->time_ms - now_ms));
+        }
+
+        if (event->gpio < 0) {
+            fflush(hal_host_trace_file());
+            fflush(stdout);
+            exit(0);
+        }
+        hal_host_drive_input((uint)event->gpio, event->level);
+    }
+
+    vTaskDelete(NULL);
+}
+
+// --- GPIO ---
+
+void gpio_init(uint gpio) {
+    hal_host_gpio_function[gpio] = GPIO_FUNC_SIO;
+    hal_host_gpio_out[gpio] = false;
+    hal_host_gpio_level[gpio] = false;
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+    hal_host_gpio_out[gpio] = out;
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn) {
+    hal_host_gpio_function[gpio] = fn;
+}
+
+void gpio_pull_up(uint gpio) {
+    hal_host_gpio_level[gpio] = true; // Botão solto
+}
+
+void gpio_put(uint gpio, bool value) {
+    if (hal_host_gpio_level[gpio] != value || !hal_host_gpio_out[gpio]) {
+        fprintf(hal_host_trace_file(), "%llu GPIO %u %d\n", (unsigned long long)time_us_64(), gpio, value);
+    }
+    hal_host_gpio_level[gpio] = value;
+}
+
+bool gpio_get(uint gpio) {
+    return hal_host_gpio_level[gpio];
+}
+
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled) {
+    if (enabled) {
+        hal_host_gpio_irq_mask[gpio] |= event_mask;
+    }
+    else {
+        hal_host_gpio_irq_mask[gpio] &= ~event_mask;
+    }
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled, gpio_irq_callback_t callback) {
+    hal_host_gpio_callback = callback;
+    gpio_set_irq_enabled(gpio, event_mask, enabled);
+
+    // O roteiro começa a ser reproduzido quando alguém passa a ouvir as interrupções
+    if (!hal_host_script_started) {
+        hal_host_script_started = true;
+        hal_host_load_script();
+#if configSUPPORT_STATIC_ALLOCATION
+        static StackType_t stack[configMINIMAL_STACK_SIZE];
+        static StaticTask_t tcb;
+        xTaskCreateStatic(hal_host_script_task, "HAL Input", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 2, stack, &tcb);
+#else
+        xTaskCreate(hal_host_script_task, "HAL Input", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 2, NULL);
+#endif
+    }
+}
+
+// --- PWM ---
+
+void pwm_init(uint slice_num, pwm_config *config, bool start) {
+    (void)start;
+    hal_host_pwm_wrap[slice_num] = config->wrap;
+}
+
+void pwm_set_chan_level(uint slice_num, uint chan, uint16_t level) {
+    // Registra o nível em cada pino ligado ao slice/canal (no RP2040 os pinos 16..29 repetem os slices)
+    for (uint gpio = 0; gpio < HAL_HOST_NUM_GPIOS; gpio++) {
+        if (hal_host_gpio_function[gpio] == GPIO_FUNC_PWM &&
+            pwm_gpio_to_slice_num(gpio) == slice_num && pwm_gpio_to_channel(gpio) == chan) {
+            fprintf(hal_host_trace_file(), "%llu PWM %u %u %u\n", (unsigned long long)time_us_64(), gpio, level, hal_host_pwm_wrap[slice_num]);
+        }
+    }
+}
+
+// --- I2C ---
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+    i2c->baudrate = baudrate;
+    return baudrate;
+}
+
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baudrate) {
+    i2c->baudrate = baudrate;
+    return baudrate;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void)nostop;
+    hal_host_record_i2c(i2c, addr, src, len);
+    return (int)len;
+}
+
+// O display simulado está sempre ligado: status com o bit D (display desligado) em zero
+int i2c_read_timeout_us(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop, uint timeout_us) {
+    (void)i2c;
+    (void)addr;
+    (void)nostop;
+    (void)timeout_us;
+    for (size_t i = 0; i < len; i++) {
+        dst[i] = 0x03;
+    }
+    return (int)len;
+}
@@ -0,0 +1,31 @@
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+#ifndef hal_host_inc_h
+#define hal_host_inc_h
+
+// Camada de hardware simulada da compilação no host.
+//
+// Variáveis de ambiente:
+//   REFLEX_INPUT     roteiro de botões, uma linha por evento: "<ms> <gpio> <nivel>" (nível 0 = apertado)
+//                    ou "<ms> exit" para encerrar o programa; linhas iniciadas por '#' são ignoradas
+//   REFLEX_HOST_LOG  arquivo onde LEDs, buzzers e I2C são registrados (padrão: stderr; não confundir com
+//                    a opção REFLEX_TRACE do cmake, que liga as estatísticas de execução)
+//   REFLEX_SEED      semente de get_rand_32 (padrão: 1)
+//   REFLEX_AUDIO     arquivo onde as amostras dos buzzers são gravadas (8 bits sem sinal, saídas intercaladas)
+//
+// Cada linha do registro começa com o instante em microssegundos:
+//   "<us> GPIO <gpio> <nivel>", "<us> PWM <gpio> <nivel> <wrap>",
+//   "<us> I2C<barramento> 0x<endereco> <bytes> <hex...>" (por exemplo "1200 I2C1 0x3c 2 80 a6"),
+//   "<us> AUDIO <gpio> <pico>" (no início de um som, com o pico do primeiro bloco, e no fim, com pico 0)
+
+// Registra uma escrita no barramento (também usada pelo substituto do DMA)
+void hal_host_record_i2c(i2c_inst_t *i2c, uint8_t address, const uint8_t *data, size_t length);
+
+// Registra o início ou o fim de um som num buzzer (usada pelo substituto do DMA de áudio)
+void hal_host_record_audio(uint gpio, uint peak);
+
+// Liga ou desliga o registro das escritas I2C (ligado por padrão); os benchmarks o desligam para medir só o driver
+void hal_host_set_i2c_recording(bool enabled);
+
+#endif
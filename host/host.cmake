@@ -0,0 +1,162 @@
+# Compilação do jogo para Linux sobre o port POSIX do FreeRTOS.
+# Incluído pelo CMakeLists.txt principal quando REFLEX_HOST_BUILD=ON; não usa o SDK do Pico.
+
+project(${ProjectName}-host C)
+
+set(CMAKE_C_STANDARD 11)
+set(CMAKE_C_STANDARD_REQUIRED ON)
+set(CMAKE_C_EXTENSIONS ON)
+
+find_package(Threads REQUIRED)
+
+set(HOST_DIR ${CMAKE_CURRENT_LIST_DIR})
+set(REPO_DIR ${CMAKE_CURRENT_LIST_DIR}/..)
+set(FREERTOS_POSIX_PORT ${FREERTOS_PATH}/portable/ThirdParty/GCC/Posix)
+
+# Núcleo do FreeRTOS com o port POSIX e o mesmo heap_4 do firmware (nenhum heap no perfil estático)
+add_library(freertos_host STATIC
+   ${FREERTOS_PATH}/tasks.c
+   ${FREERTOS_PATH}/queue.c
+   ${FREERTOS_PATH}/list.c
+   ${FREERTOS_PATH}/timers.c
+   ${FREERTOS_PATH}/event_groups.c
+   ${FREERTOS_PATH}/stream_buffer.c
+   ${FREERTOS_POSIX_PORT}/port.c
+   ${FREERTOS_POSIX_PORT}/utils/wait_for_event.c
+)
+
+if (REFLEX_STATIC_ALLOC)
+   target_compile_definitions(freertos_host PUBLIC REFLEX_STATIC_ALLOC=1)
+else()
+   target_sources(freertos_host PRIVATE ${FREERTOS_PATH}/portable/MemMang/heap_4.c)
+endif()
+
+if (REFLEX_TRACE)
+   target_compile_definitions(freertos_host PUBLIC REFLEX_TRACE=1)
+endif()
+
+if (REFLEX_SCOREBOARD)
+   target_compile_definitions(freertos_host PUBLIC REFLEX_SCOREBOARD=1)
+endif()
+
+target_compile_definitions(freertos_host PUBLIC ssd1306_i2c_clock=${REFLEX_I2C_KHZ})
+if (REFLEX_I2C_PROBE)
+   target_compile_definitions(freertos_host PUBLIC REFLEX_I2C_PROBE=1)
+endif()
+
+if (REFLEX_RECORD)
+   target_compile_definitions(freertos_host PUBLIC REFLEX_RECORD=1)
+endif()
+
+target_include_directories(freertos_host PUBLIC
+   ${REPO_DIR}/include
+   ${FREERTOS_PATH}/include
+   ${FREERTOS_POSIX_PORT}
+   ${FREERTOS_POSIX_PORT}/utils
+)
+
+target_compile_definitions(freertos_host PUBLIC REFLEX_HOST_BUILD=1)
+target_link_libraries(freertos_host PUBLIC Threads::Threads)
+
+# Camada de hardware simulada (GPIO, PWM, I2C, relógio, números aleatórios e DMA do display e do áudio)
+add_library(hal_host STATIC
+   ${HOST_DIR}/hal_host.c
+   ${HOST_DIR}/ssd1306_dma_host.c
+   ${HOST_DIR}/audio_dma_host.c
+)
+
+target_include_directories(hal_host PUBLIC
+   ${HOST_DIR}
+   ${HOST_DIR}/include
+   ${REPO_DIR}/inc
+)
+
+target_include_directories(hal_host PRIVATE ${REPO_DIR}/src)
+target_link_libraries(hal_host PUBLIC freertos_host)
+
+# Mesmas fontes do firmware, trocando apenas os transportes DMA do display e do áudio
+add_executable(${ProjectName}-host
+   ${REPO_DIR}/src/main.c
+   ${REPO_DIR}/src/input.c
+   ${REPO_DIR}/src/reaction_stats.c
+   ${REPO_DIR}/src/game_state.c
+   ${REPO_DIR}/src/rtos_alloc.c
+   ${REPO_DIR}/src/audio.c
+   ${REPO_DIR}/src/trace.c
+   ${REPO_DIR}/src/scoreboard.c
+   ${REPO_DIR}/src/reflex_game.c
+   ${REPO_DIR}/src/reflex_log.c
+   ${REPO_DIR}/src/deadline.c
+   ${REPO_DIR}/src/mem_stats.c
+   ${REPO_DIR}/inc/ssd1306_i2c.c
+   ${REPO_DIR}/inc/ssd1306_gfx.c
+   ${REPO_DIR}/inc/ssd1306_sprite.c
+   ${REPO_DIR}/inc/ssd1306_probe.c
+)
+
+target_include_directories(${ProjectName}-host PRIVATE
+   ${REPO_DIR}
+   ${REPO_DIR}/src
+)
+
+reflex_audio_tables(${ProjectName}-host)
+reflex_assets(${ProjectName}-host)
+target_link_libraries(${ProjectName}-host PRIVATE hal_host)
+
+# Reprodução das partidas gravadas com REFLEX_RECORD (./reflex_replay partida.bin imprime CSV e retorna 1 se
+# a partida refeita com as regras atuais divergir da gravada)
+add_executable(reflex_replay
+   ${HOST_DIR}/reflex_replay.c
+   ${REPO_DIR}/src/reflex_game.c
+   ${REPO_DIR}/src/reaction_stats.c
+)
+
+target_include_directories(reflex_replay PRIVATE ${REPO_DIR}/src)
+target_link_libraries(reflex_replay PRIVATE hal_host)
+
+# Teste da ordem de conclusão dos envios do display por DMA, com o substituto em host/ssd1306_dma_host.c
+# (ctest --test-dir build-host)
+add_executable(ssd1306_dma_test
+   ${HOST_DIR}/ssd1306_dma_test.c
+   ${REPO_DIR}/src/rtos_alloc.c
+   ${REPO_DIR}/src/mem_stats.c
+   ${REPO_DIR}/src/trace.c
+   ${REPO_DIR}/inc/ssd1306_i2c.c
+)
+
+target_include_directories(ssd1306_dma_test PRIVATE ${REPO_DIR}/src)
+reflex_assets(ssd1306_dma_test)
+target_link_libraries(ssd1306_dma_test PRIVATE hal_host)
+
+enable_testing()
+add_test(NAME ssd1306_dma COMMAND ssd1306_dma_test)
+set_tests_properties(ssd1306_dma PROPERTIES TIMEOUT 10)
+
+# Microbenchmark das primitivas gráficas (./gfx_bench imprime CSV; não faz parte do jogo)
+add_executable(gfx_bench
+   ${REPO_DIR}/bench/gfx_bench.c
+   ${REPO_DIR}/inc/ssd1306_gfx.c
+   ${REPO_DIR}/inc/ssd1306_i2c.c
+)
+
+reflex_assets(gfx_bench)
+target_link_libraries(gfx_bench PRIVATE hal_host)
+
+# Benchmark do caminho de desenho e envio (custo de CPU relativo ao set_pixel original, bytes e transações por
+# quadro). O alvo bench roda os dois benchmarks e falha se o custo ou o tráfego no barramento piorarem em relação
+# a bench/render_bench_baseline.csv
+add_executable(render_bench
+   ${REPO_DIR}/bench/render_bench.c
+   ${REPO_DIR}/inc/ssd1306_gfx.c
+   ${REPO_DIR}/inc/ssd1306_i2c.c
+)
+
+reflex_assets(render_bench)
+target_link_libraries(render_bench PRIVATE hal_host)
+
+add_custom_target(bench
+   COMMAND gfx_bench
+   COMMAND render_bench ${REPO_DIR}/bench/render_bench_baseline.csv
+   DEPENDS gfx_bench render_bench
+   USES_TERMINAL
+)
@@ -0,0 +1,34 @@
+// Substituto do hardware/i2c.h para a compilação no host: as escritas são registradas e sempre reconhecidas
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef host_hardware_i2c_h
+#define host_hardware_i2c_h
+
+typedef unsigned int uint;
+
+typedef struct i2c_inst {
+    uint index;
+    uint baudrate;
+} i2c_inst_t;
+
+extern i2c_inst_t i2c0_inst;
+extern i2c_inst_t i2c1_inst;
+
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+// Bit de STOP do registrador IC_DATA_CMD (usado pelo transporte DMA do driver)
+#define I2C_IC_DATA_CMD_STOP_BITS 0x00000200u
+
+static inline uint i2c_hw_index(i2c_inst_t *i2c) {
+    return i2c->index;
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+int i2c_read_timeout_us(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop, uint timeout_us);
+
+#endif
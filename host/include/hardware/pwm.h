@@ -0,0 +1,45 @@
+// Substituto do hardware/pwm.h para a compilação no host: os níveis dos buzzers são registrados
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef host_hardware_pwm_h
+#define host_hardware_pwm_h
+
+typedef unsigned int uint;
+
+typedef struct {
+    float clkdiv;
+    uint16_t wrap;
+} pwm_config;
+
+enum pwm_chan {
+    PWM_CHAN_A = 0,
+    PWM_CHAN_B = 1
+};
+
+// Mesmo mapeamento do RP2040: dois canais por slice, oito slices
+static inline uint pwm_gpio_to_slice_num(uint gpio) {
+    return (gpio >> 1u) & 7u;
+}
+
+static inline uint pwm_gpio_to_channel(uint gpio) {
+    return gpio & 1u;
+}
+
+static inline pwm_config pwm_get_default_config(void) {
+    pwm_config config = {1.0f, 0xffff};
+    return config;
+}
+
+static inline void pwm_config_set_clkdiv(pwm_config *config, float div) {
+    config->clkdiv = div;
+}
+
+static inline void pwm_config_set_wrap(pwm_config *config, uint16_t wrap) {
+    config->wrap = wrap;
+}
+
+void pwm_init(uint slice_num, pwm_config *config, bool start);
+void pwm_set_chan_level(uint slice_num, uint chan, uint16_t level);
+
+#endif
@@ -0,0 +1,27 @@
+// Substituto do hardware/timer.h para a compilação no host (relógio monotônico do sistema)
+#include <stdint.h>
+
+#ifndef host_hardware_timer_h
+#define host_hardware_timer_h
+
+typedef uint64_t absolute_time_t;
+
+uint64_t time_us_64(void);
+
+static inline uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+static inline absolute_time_t get_absolute_time(void) {
+    return time_us_64();
+}
+
+static inline uint64_t to_us_since_boot(absolute_time_t t) {
+    return t;
+}
+
+static inline uint32_t to_ms_since_boot(absolute_time_t t) {
+    return (uint32_t)(t / 1000);
+}
+
+#endif
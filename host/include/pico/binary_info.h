@@ -0,0 +1 @@
+// Substituto do pico/binary_info.h para a compilação no host (sem efeito)
@@ -0,0 +1,9 @@
+// Substituto do pico/rand.h para a compilação no host: sequência reprodutível a partir de REFLEX_SEED
+#include <stdint.h>
+
+#ifndef host_pico_rand_h
+#define host_pico_rand_h
+
+uint32_t get_rand_32(void);
+
+#endif
@@ -0,0 +1,41 @@
+// Substituto mínimo do pico/stdlib.h para a compilação no host (Linux, port POSIX do FreeRTOS)
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <assert.h>
+
+#ifndef host_pico_stdlib_h
+#define host_pico_stdlib_h
+
+typedef unsigned int uint;
+
+#define _u(x) x ## u
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+
+#include "hardware/gpio.h"
+#include "hardware/timer.h"
+
+bool stdio_init_all(void);
+
+// Mensagem de erro fatal e fim do processo (no RP2040, imprime e para o processador)
+void panic(const char *fmt, ...);
+
+// Escreve o byte sem conversão de fim de linha (quadros binários do rastro)
+static inline void putchar_raw(int c) {
+    putchar(c);
+}
+
+// Escreve o bloco de uma vez, sem conversão de fim de linha quando cr_translation é falso
+static inline int stdio_put_string(const char *s, int len, bool newline, bool cr_translation) {
+    (void)cr_translation;
+    fwrite(s, 1, (size_t)len, stdout);
+    if (newline) {
+        putchar('\n');
+    }
+    return len;
+}
+
+static inline void tight_loop_contents(void) {}
+
+#endif
@@ -0,0 +1,242 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pico/stdlib.h"
+#include "reflex_game.h"
+#include "reflex_log.h"
+#include "reaction_stats.h"
+
+// Reprodução (no computador) de partidas gravadas com REFLEX_RECORD. Lê os quadros "RXLG" de um arquivo (o
+// registro do host ou uma captura da USB, com texto no meio) e refaz cada partida com as regras de
+// src/reflex_game.c em tempo virtual: a semente refaz as cores e cada aperto gravado é aplicado à mesma
+// distância do estímulo da sua rodada. Nenhuma espera é real, então uma partida de 60 s leva microssegundos.
+//
+// Imprime uma linha CSV por partida:
+// arquivo,partida,semente,rodadas,acertos,pontuacao,divergencias,p50_ms,p95_ms,atraso_medio_us,atraso_max_us,tempo_us,confere
+// divergencias conta as rodadas em que a cor, o acerto ou a espera refeitos diferem dos gravados; atraso é o
+// tempo gravado entre o fim da espera de uma rodada e o estímulo da seguinte (custo do laço do jogo e do
+// escalonador). confere fica em 0, e o programa retorna 1, se a partida divergir, se a pontuação não bater
+// ou se o atraso máximo passar do limite dado com -a <µs>. A duração do som e os botões de cada cor vêm do
+// cabeçalho do quadro, ou seja, da configuração com que a partida foi jogada
+
+#define REPLAY_MAX_FILE     (1 << 20)
+
+typedef struct {
+    uint32_t seed;
+    uint note_ms;
+    uint buttons[REFLEX_GAME_NUM_COLORS];
+    uint32_t count;
+    reflex_log_record_t records[REFLEX_LOG_MAX_RECORDS];
+} replay_session_t;
+
+typedef struct {
+    int rounds;
+    int hits;
+    int score;
+    int divergences;
+    reaction_summary_t summary;
+    uint64_t overhead_sum_us;
+    uint32_t overhead_max_us;
+    int overhead_count;
+} replay_result_t;
+
+static uint32_t replay_get_u32(const uint8_t *bytes) {
+    return bytes[0] | (uint32_t)bytes[1] << 8 | (uint32_t)bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+}
+
+// Decodifica o quadro em data[0..]; retorna o tamanho consumido ou 0 se o quadro estiver incompleto
+static size_t replay_parse(const uint8_t *data, size_t length, replay_session_t *session) {
+    if (length < REFLEX_LOG_HEADER_SIZE || data[4] != REFLEX_LOG_VERSION) {
+        return 0;
+    }
+
+    for (int i = 0; i < REFLEX_GAME_NUM_COLORS; i++) {
+        session->buttons[i] = data[5 + i];
+    }
+    session->seed = replay_get_u32(&data[8]);
+    session->count = replay_get_u32(&data[12]);
+    session->note_ms = data[16] | (uint)data[17] << 8;
+    if (session->count > REFLEX_LOG_MAX_RECORDS ||
+        length < REFLEX_LOG_HEADER_SIZE + (size_t)session->count * sizeof(reflex_log_record_t)) {
+        return 0;
+    }
+
+    const uint8_t *bytes = &data[REFLEX_LOG_HEADER_SIZE];
+    for (uint32_t i = 0; i < session->count; i++, bytes += sizeof(reflex_log_record_t)) {
+        reflex_log_record_t *record = &session->records[i];
+
+        record->time_us = replay_get_u32(bytes);
+        record->type = bytes[4];
+        record->arg0 = bytes[5];
+        record->arg1 = bytes[6] | (uint16_t)bytes[7] << 8;
+    }
+
+    return REFLEX_LOG_HEADER_SIZE + session->count * sizeof(reflex_log_record_t);
+}
+
+// Refaz a partida. Cada rodada vai do seu estímulo até o próximo estímulo (ou o fim) e termina com o
+// resultado gravado; os apertos são medidos a partir do estímulo, como faz a tarefa do jogo
+static void replay_run(const replay_session_t *session, replay_result_t *result) {
+    static reaction_stats_t stats;
+    reflex_game_t game;
+    uint32_t end_us = UINT32_MAX;
+    int64_t next_expected_us = -1;      // Instante gravado do resultado mais a espera (início previsto da rodada)
+
+    memset(result, 0, sizeof(*result));
+    reaction_stats_reset(&stats);
+    reflex_game_init(&game, session->seed, session->note_ms, session->buttons);
+
+    for (uint32_t i = 0; i < session->count; i++) {
+        if (session->records[i].type == REFLEX_LOG_END) {
+            end_us = session->records[i].time_us;
+            result->score = session->records[i].arg1;
+        }
+    }
+
+    for (uint32_t i = 0; i < session->count; i++) {
+        const reflex_log_record_t *stimulus = &session->records[i];
+
+        if (stimulus->type != REFLEX_LOG_STIMULUS) {
+            continue;
+        }
+
+        if (next_expected_us >= 0 && stimulus->time_us > next_expected_us) {
+            uint32_t overhead_us = stimulus->time_us - (uint32_t)next_expected_us;
+
+            result->overhead_sum_us += overhead_us;
+            result->overhead_count++;
+            if (overhead_us > result->overhead_max_us) {
+                result->overhead_max_us = overhead_us;
+            }
+        }
+
+        uint color = reflex_game_start_round(&game);
+        uint32_t window_us = reflex_game_window_ms(&game) * 1000;
+        bool hit = false;
+        const reflex_log_record_t *recorded = NULL;
+
+        result->rounds++;
+        if (color != stimulus->arg0) {
+            result->divergences++;
+        }
+
+        for (uint32_t j = i + 1; j < session->count; j++) {
+            const reflex_log_record_t *record = &session->records[j];
+
+            if (record->type == REFLEX_LOG_STIMULUS || record->type == REFLEX_LOG_END) {
+                break;
+            }
+            if (record->type == REFLEX_LOG_RESULT) {
+                recorded = record;
+            }
+            else if (record->type == REFLEX_LOG_PRESS && !hit) {
+                uint32_t offset_us = record->time_us > stimulus->time_us ? record->time_us - stimulus->time_us : 0;
+
+                if (offset_us < window_us && record->time_us < end_us && reflex_game_is_hit(&game, record->arg0)) {
+                    hit = true;
+                    reaction_stats_record(&stats, color, stimulus->time_us, record->time_us);
+                }
+            }
+        }
+
+        // Rodada interrompida pelo fim da partida não conta como tempo esgotado (como na tarefa do jogo)
+        if (!hit && (uint64_t)stimulus->time_us + window_us <= end_us) {
+            reaction_stats_record_timeout(&stats, color);
+        }
+
+        int delay_ms = reflex_game_finish_round(&game, hit);
+        if (hit) {
+            result->hits++;
+        }
+
+        if (recorded == NULL || recorded->arg0 != hit || recorded->arg1 != delay_ms) {
+            result->divergences++;
+            next_expected_us = -1;
+        }
+        else {
+            next_expected_us = (int64_t)recorded->time_us + (int64_t)delay_ms * 1000;
+        }
+    }
+
+    reaction_stats_summary(&stats, REACTION_STATS_ALL_COLORS, &result->summary);
+}
+
+static uint64_t replay_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// Reproduz todas as partidas do arquivo; retorna falso se alguma não conferir
+static bool replay_file(const char *path, uint32_t overhead_limit_us) {
+    static uint8_t data[REPLAY_MAX_FILE];
+    static replay_session_t session;
+    FILE *file = fopen(path, "rb");
+    bool ok = true;
+    int sessions = 0;
+
+    if (file == NULL) {
+        fprintf(stderr, "reflex_replay: nao foi possivel abrir %s\n", path);
+        return false;
+    }
+    size_t length = fread(data, 1, sizeof(data), file);
+    fclose(file);
+
+    for (size_t i = 0; i + REFLEX_LOG_HEADER_SIZE <= length; i++) {
+        if (memcmp(&data[i], REFLEX_LOG_MAGIC, 4) != 0) {
+            continue;
+        }
+
+        size_t used = replay_parse(&data[i], length - i, &session);
+        if (used == 0) {
+            continue;
+        }
+
+        replay_result_t result;
+        uint64_t start_ns = replay_now_ns();
+        replay_run(&session, &result);
+        uint64_t elapsed_ns = replay_now_ns() - start_ns;
+
+        bool session_ok = result.divergences == 0 && result.hits == result.score &&
+                          (overhead_limit_us == 0 || result.overhead_max_us <= overhead_limit_us);
+        ok = ok && session_ok;
+
+        printf("%s,%d,%lu,%d,%d,%d,%d,%lu,%lu,%lu,%lu,%.1f,%d\n", path, sessions, (unsigned long)session.seed,
+               result.rounds, result.hits, result.score, result.divergences,
+               (unsigned long)(result.summary.p50_us / 1000), (unsigned long)(result.summary.p95_us / 1000),
+               (unsigned long)(result.overhead_count > 0 ? result.overhead_sum_us / result.overhead_count : 0),
+               (unsigned long)result.overhead_max_us, elapsed_ns / 1000.0, session_ok);
+
+        sessions++;
+        i += used - 1;
+    }
+
+    if (sessions == 0) {
+        fprintf(stderr, "reflex_replay: nenhuma partida em %s\n", path);
+        return false;
+    }
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    uint32_t overhead_limit_us = 0;
+    bool ok = true;
+    int first = 1;
+
+    if (argc > 2 && strcmp(argv[1], "-a") == 0) {
+        overhead_limit_us = (uint32_t)strtoul(argv[2], NULL, 0);
+        first = 3;
+    }
+    if (first >= argc) {
+        fprintf(stderr, "uso: reflex_replay [-a atraso_max_us] partida.bin...\n");
+        return 2;
+    }
+
+    printf("arquivo,partida,semente,rodadas,acertos,pontuacao,divergencias,p50_ms,p95_ms,atraso_medio_us,atraso_max_us,tempo_us,confere\n");
+    for (int i = first; i < argc; i++) {
+        ok = replay_file(argv[i], overhead_limit_us) && ok;
+    }
+
+    return ok ? 0 : 1;
+}
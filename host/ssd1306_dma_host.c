@@ -0,0 +1,73 @@
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "ssd1306_dma.h"
+#include "ssd1306_dma_host.h"
+#include "hal_host.h"
+
+// Substituto do transporte DMA/I2C para a compilação no host: guarda o conteúdo enviado
+// e conclui as transferências na mesma ordem em que foram iniciadas
+
+#define SSD1306_DMA_HOST_MAX_PAYLOAD 1100
+
+typedef struct {
+    ssd1306_dma_callback_t on_complete;
+    uint pending;
+    uint8_t address;
+    uint8_t payload[SSD1306_DMA_HOST_MAX_PAYLOAD];
+    uint length;
+} ssd1306_dma_host_port_t;
+
+static ssd1306_dma_host_port_t ssd1306_dma_host_ports[2];
+static bool ssd1306_dma_host_auto = true;
+
+void ssd1306_dma_host_set_auto_complete(bool enabled) {
+    ssd1306_dma_host_auto = enabled;
+}
+
+uint ssd1306_dma_host_pending(i2c_inst_t *i2c) {
+    return ssd1306_dma_host_ports[i2c_hw_index(i2c)].pending;
+}
+
+bool ssd1306_dma_host_complete(i2c_inst_t *i2c, bool ok) {
+    ssd1306_dma_host_port_t *port = &ssd1306_dma_host_ports[i2c_hw_index(i2c)];
+
+    if (port->pending == 0) {
+        return false;
+    }
+
+    port->pending--;
+    port->on_complete(i2c, ok);
+    return true;
+}
+
+const uint8_t *ssd1306_dma_host_last_payload(i2c_inst_t *i2c, uint *length) {
+    ssd1306_dma_host_port_t *port = &ssd1306_dma_host_ports[i2c_hw_index(i2c)];
+
+    *length = port->length;
+    return port->payload;
+}
+
+void ssd1306_dma_init(i2c_inst_t *i2c, ssd1306_dma_callback_t on_complete) {
+    ssd1306_dma_host_ports[i2c_hw_index(i2c)].on_complete = on_complete;
+}
+
+void ssd1306_dma_start(i2c_inst_t *i2c, uint8_t address, const uint16_t *words, uint count) {
+    ssd1306_dma_host_port_t *port = &ssd1306_dma_host_ports[i2c_hw_index(i2c)];
+
+    // O hardware real só aceita uma transferência por vez; o driver deve aguardar a anterior
+    assert(port->pending == 0);
+    assert(count > 0 && (words[count - 1] & I2C_IC_DATA_CMD_STOP_BITS));
+
+    port->address = address;
+    port->length = count < SSD1306_DMA_HOST_MAX_PAYLOAD ? count : SSD1306_DMA_HOST_MAX_PAYLOAD;
+    for (uint i = 0; i < port->length; i++) {
+        port->payload[i] = (uint8_t)words[i];
+    }
+    port->pending++;
+
+    hal_host_record_i2c(i2c, address, port->payload, port->length);
+
+    if (ssd1306_dma_host_auto) {
+        ssd1306_dma_host_complete(i2c, true);
+    }
+}
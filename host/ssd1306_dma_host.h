@@ -0,0 +1,20 @@
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+#ifndef ssd1306_dma_host_inc_h
+#define ssd1306_dma_host_inc_h
+
+// Com conclusão automática (padrão), cada transferência termina dentro de ssd1306_dma_start.
+// Desligada, as transferências ficam pendentes até ssd1306_dma_host_complete()
+void ssd1306_dma_host_set_auto_complete(bool enabled);
+
+// Quantidade de transferências iniciadas e ainda não concluídas no barramento
+uint ssd1306_dma_host_pending(i2c_inst_t *i2c);
+
+// Conclui a transferência pendente mais antiga do barramento, como faria a interrupção de STOP
+bool ssd1306_dma_host_complete(i2c_inst_t *i2c, bool ok);
+
+// Último envio recebido pelo substituto (bytes já sem os bits de controle do IC_DATA_CMD)
+const uint8_t *ssd1306_dma_host_last_payload(i2c_inst_t *i2c, uint *length);
+
+#endif
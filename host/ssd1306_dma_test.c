@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "ssd1306.h"
+#include "ssd1306_dma_host.h"
+#include "hal_host.h"
+#include "rtos_alloc.h"
+
+// Teste da ordem de conclusão dos envios do display por DMA (ctest, só na compilação do host).
+// Com a conclusão automática desligada, cada quadro fica pendente no barramento até a tarefa de conclusão
+// chamar ssd1306_dma_host_complete, como faria a interrupção de STOP. Ela tem prioridade menor que a tarefa
+// do teste e só roda enquanto esta está bloqueada: uma conclusão contada durante uma chamada do driver
+// prova que a chamada esperou pelo envio em andamento
+
+#define TEST_STACK_DEPTH (configMINIMAL_STACK_SIZE * 4)
+
+SSD1306_STORAGE(test, ssd1306_width, ssd1306_height);
+RTOS_TASK_STORAGE(test_main, TEST_STACK_DEPTH);
+RTOS_TASK_STORAGE(test_completer, configMINIMAL_STACK_SIZE * 2);
+RTOS_TASK_STORAGE(test_other, configMINIMAL_STACK_SIZE * 2);
+
+static ssd1306_t test_display;
+static volatile uint test_completions = 0;
+static volatile bool test_next_ok = true;   // Resultado entregue na próxima conclusão
+static int test_failures = 0;
+
+// Resultado da espera feita por uma tarefa que não iniciou o envio
+static volatile bool test_other_done = false;
+static volatile bool test_other_ok = false;
+static volatile uint test_other_completions = 0;
+
+#define TEST_CHECK(condition) test_check((condition), #condition, __LINE__)
+
+static void test_check(bool condition, const char *text, int line) {
+    if (!condition) {
+        printf("FALHA (linha %d): %s\n", line, text);
+        test_failures++;
+    }
+}
+
+// Conclui o envio pendente um tick depois de a tarefa do teste bloquear. O contador sobe antes da
+// conclusão, porque a notificação devolve o processador à tarefa do teste na mesma hora
+static void test_completer_task(void *params) {
+    for (;;) {
+        vTaskDelay(1);
+        if (ssd1306_dma_host_pending(i2c1) > 0) {
+            test_completions++;
+            ssd1306_dma_host_complete(i2c1, test_next_ok);
+        }
+    }
+}
+
+// Espera pelo envio iniciado pela tarefa do teste e termina
+static void test_other_task(void *params) {
+    test_other_ok = ssd1306_display_wait(&test_display, portMAX_DELAY);
+    test_other_completions = test_completions;
+    test_other_done = true;
+    vTaskDelete(NULL);
+}
+
+static void test_main_task(void *params) {
+    uint8_t *back;
+    uint length;
+    const uint8_t *payload;
+
+    hal_host_set_i2c_recording(false);
+    ssd1306_dma_host_set_auto_complete(false);
+    SSD1306_INIT_DISPLAY(&test_display, test, ssd1306_width, ssd1306_height, false, ssd1306_i2c_address, i2c1);
+
+    // Primeiro quadro: vai inteiro e fica pendente; flip não espera o envio
+    back = ssd1306_display_back_buffer(&test_display);
+    memset(back, 0xAA, ssd1306_buffer_length);
+    TEST_CHECK(ssd1306_display_flip(&test_display) == ssd1306_buffer_length);
+    TEST_CHECK(ssd1306_dma_host_pending(i2c1) == 1);
+    TEST_CHECK(test_completions == 0);
+    TEST_CHECK(!ssd1306_display_wait(&test_display, 0));
+
+    payload = ssd1306_dma_host_last_payload(i2c1, &length);
+    TEST_CHECK(length == ssd1306_buffer_length + 1);
+    TEST_CHECK(payload[0] == 0x40 && payload[1] == 0xAA);
+
+    // Um comando só vai ao barramento depois do quadro em andamento
+    ssd1306_command(&test_display, ssd1306_set_normal_display);
+    TEST_CHECK(test_completions == 1);
+    TEST_CHECK(ssd1306_dma_host_pending(i2c1) == 0);
+
+    // Segundo quadro: só o byte alterado; o barramento está livre, então flip não bloqueia
+    back = ssd1306_display_back_buffer(&test_display);
+    back[0] ^= 0xFF;
+    TEST_CHECK(ssd1306_display_flip(&test_display) == 1);
+    TEST_CHECK(test_completions == 1);
+    TEST_CHECK(ssd1306_dma_host_pending(i2c1) == 1);
+
+    // Terceiro quadro com o segundo ainda no barramento: flip espera a conclusão antes de comparar e enviar
+    back = ssd1306_display_back_buffer(&test_display);
+    back[ssd1306_buffer_length - 1] ^= 0xFF;
+    ssd1306_display_flip(&test_display);
+    TEST_CHECK(test_completions == 2);
+    TEST_CHECK(ssd1306_dma_host_pending(i2c1) == 1);
+
+    // wait bloqueia até o fim do terceiro
+    TEST_CHECK(ssd1306_display_wait(&test_display, portMAX_DELAY));
+    TEST_CHECK(test_completions == 3);
+    TEST_CHECK(ssd1306_dma_host_pending(i2c1) == 0);
+
+    // Outra tarefa, de prioridade maior, espera pelo quadro enviado por esta: as duas acordam na conclusão
+    back = ssd1306_display_back_buffer(&test_display);
+    back[0] ^= 0xFF;
+    ssd1306_display_flip(&test_display);
+    RTOS_TASK_CREATE(test_other, test_other_task, "Other", configMINIMAL_STACK_SIZE * 2, NULL, 3, RTOS_ANY_CORE);
+    TEST_CHECK(ssd1306_display_wait(&test_display, portMAX_DELAY));
+    TEST_CHECK(test_other_done && test_other_ok);
+    TEST_CHECK(test_other_completions == 4);
+
+    // Erro no barramento chega a quem espera
+    test_next_ok = false;
+    back = ssd1306_display_back_buffer(&test_display);
+    back[0] ^= 0xFF;
+    ssd1306_display_flip(&test_display);
+    TEST_CHECK(!ssd1306_display_wait(&test_display, portMAX_DELAY));
+    TEST_CHECK(test_completions == 5);
+
+    // O quadro que falhou pode não ter chegado ao display: o próximo vai inteiro, e depois as diferenças voltam
+    test_next_ok = true;
+    back = ssd1306_display_back_buffer(&test_display);
+    back[1] ^= 0xFF;
+    TEST_CHECK(ssd1306_display_flip(&test_display) == ssd1306_buffer_length);
+    TEST_CHECK(ssd1306_display_wait(&test_display, portMAX_DELAY));
+    back = ssd1306_display_back_buffer(&test_display);
+    back[1] ^= 0xFF;
+    TEST_CHECK(ssd1306_display_flip(&test_display) == 1);
+    TEST_CHECK(ssd1306_display_wait(&test_display, portMAX_DELAY));
+    TEST_CHECK(test_completions == 7);
+
+    printf("ssd1306_dma_test: %s\n", test_failures == 0 ? "ok" : "FALHOU");
+    fflush(stdout);
+    exit(test_failures == 0 ? 0 : 1);
+}
+
+int main() {
+    stdio_init_all();
+
+    RTOS_TASK_CREATE(test_main, test_main_task, "Test", TEST_STACK_DEPTH, NULL, 2, RTOS_ANY_CORE);
+    RTOS_TASK_CREATE(test_completer, test_completer_task, "Completer", configMINIMAL_STACK_SIZE * 2, NULL, 1,
+                     RTOS_ANY_CORE);
+
+    vTaskStartScheduler();
+    return 1;
+}
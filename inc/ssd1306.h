@@ -1,17 +1,45 @@
-#include "ssd1306_i2c.h"
-extern void calculate_render_area_buffer_length(struct render_area *area);
-extern void ssd1306_send_command(uint8_t cmd);
-extern void ssd1306_send_command_list(uint8_t *ssd, int number);
-extern void ssd1306_send_buffer(uint8_t ssd[], int buffer_length);
-extern void ssd1306_init();
-extern void ssd1306_scroll(bool set);
-extern void render_on_display(uint8_t *ssd, struct render_area *area);
-extern void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set);
-extern void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set);
-extern void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character);
-extern void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string);
-extern void ssd1306_command(ssd1306_t *ssd, uint8_t command);
-extern void ssd1306_config(ssd1306_t *ssd);
-extern void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
-extern void ssd1306_send_data(ssd1306_t *ssd);
+#include "ssd1306_i2c.h"
+extern void calculate_render_area_buffer_length(struct render_area *area);
+extern void ssd1306_send_command(uint8_t cmd);
+extern void ssd1306_send_command_list(uint8_t *ssd, int number);
+extern void ssd1306_get_bus_stats(ssd1306_bus_stats_t *stats);
+extern void ssd1306_reset_bus_stats(void);
+extern void ssd1306_send_buffer(uint8_t ssd[], int buffer_length);
+extern void ssd1306_send_buffer_async(uint8_t ssd[], int buffer_length);
+extern bool ssd1306_wait_transfer(TickType_t timeout);
+extern void ssd1306_init();
+extern void ssd1306_scroll(bool set);
+extern void render_on_display(uint8_t *ssd, struct render_area *area);
+extern int render_changes_on_display(uint8_t *ssd);
+extern uint8_t *ssd1306_back_buffer(void);
+extern int ssd1306_flip(void);
+extern void ssd1306_get_frame_stats(ssd1306_frame_stats_t *stats);
+extern void ssd1306_reset_frame_stats(void);
+extern void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set);
+extern void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set);
+extern void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character);
+extern void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string);
+extern void ssd1306_frame_draw_char(uint8_t *ssd, int frame_width, int frame_height, int16_t x, int16_t y, uint8_t character);
+extern void ssd1306_frame_draw_string(uint8_t *ssd, int frame_width, int frame_height, int16_t x, int16_t y, const char *string);
+extern void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+extern void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, int number);
+extern void ssd1306_config(ssd1306_t *ssd);
+extern void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+extern void ssd1306_init_display(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c, uint8_t *frames, uint16_t *tx_words, StaticSemaphore_t *tx_idle);
+extern ssd1306_t *ssd1306_get_default(void);
+extern bool ssd1306_display_wait(ssd1306_t *ssd, TickType_t timeout);
+extern void ssd1306_display_send_async(ssd1306_t *ssd, const uint8_t *buffer, int buffer_length);
+extern void ssd1306_display_send(ssd1306_t *ssd, const uint8_t *buffer, int buffer_length);
+extern void ssd1306_display_scroll(ssd1306_t *ssd, bool set);
+extern void ssd1306_display_render(ssd1306_t *ssd, const uint8_t *buffer, struct render_area *area);
+extern int ssd1306_display_render_changes(ssd1306_t *ssd, const uint8_t *buffer);
+extern uint8_t *ssd1306_display_back_buffer(ssd1306_t *ssd);
+extern int ssd1306_display_flip(ssd1306_t *ssd);
+extern void ssd1306_display_get_bus_stats(ssd1306_t *ssd, ssd1306_bus_stats_t *stats);
+extern void ssd1306_display_reset_bus_stats(ssd1306_t *ssd);
+extern void ssd1306_display_get_frame_stats(ssd1306_t *ssd, ssd1306_frame_stats_t *stats);
+extern void ssd1306_display_reset_frame_stats(ssd1306_t *ssd);
+extern void ssd1306_init_bm_buffer(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c, uint8_t *buffer);
+extern void ssd1306_send_data(ssd1306_t *ssd);
+extern void ssd1306_send_area(ssd1306_t *ssd, const struct render_area *area);
 extern void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap);
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "ssd1306_dma.h"
+
+// Estado do transporte por barramento (i2c0 e i2c1)
+typedef struct {
+    int channel;
+    ssd1306_dma_callback_t on_complete;
+} ssd1306_dma_port_t;
+
+static ssd1306_dma_port_t ssd1306_dma_ports[2];
+
+// Fim da transferência: o STOP no barramento indica que o último byte saiu de fato da FIFO
+static void ssd1306_dma_irq(i2c_inst_t *i2c) {
+    ssd1306_dma_port_t *port = &ssd1306_dma_ports[i2c_hw_index(i2c)];
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+    bool ok = true;
+
+    if (hw->intr_stat & I2C_IC_INTR_STAT_R_TX_ABRT_BITS) {
+        // NACK ou perda de arbitragem: a FIFO é descartada e o DMA precisa ser interrompido
+        dma_channel_abort(port->channel);
+        (void)hw->clr_tx_abrt;
+        ok = false;
+    }
+
+    (void)hw->clr_stop_det;
+    hw->intr_mask = 0;
+
+    port->on_complete(i2c, ok);
+}
+
+static void ssd1306_dma_i2c0_irq(void) {
+    ssd1306_dma_irq(i2c0);
+}
+
+static void ssd1306_dma_i2c1_irq(void) {
+    ssd1306_dma_irq(i2c1);
+}
+
+void ssd1306_dma_init(i2c_inst_t *i2c, ssd1306_dma_callback_t on_complete) {
+    uint index = i2c_hw_index(i2c);
+    ssd1306_dma_port_t *port = &ssd1306_dma_ports[index];
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+
+    if (port->on_complete == NULL) {
+        port->channel = dma_claim_unused_channel(true);
+
+        // Palavras de 16 bits: o bit 9 (STOP) do IC_DATA_CMD encerra a transação no último byte
+        dma_channel_config config = dma_channel_get_default_config(port->channel);
+        channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+        channel_config_set_read_increment(&config, true);
+        channel_config_set_write_increment(&config, false);
+        channel_config_set_dreq(&config, i2c_get_dreq(i2c, true));
+        dma_channel_configure(port->channel, &config, &hw->data_cmd, NULL, 0, false);
+
+        hw->dma_cr = I2C_IC_DMA_CR_TDMAE_BITS;
+        hw->intr_mask = 0;
+
+        uint irq = index == 0 ? I2C0_IRQ : I2C1_IRQ;
+        irq_set_exclusive_handler(irq, index == 0 ? ssd1306_dma_i2c0_irq : ssd1306_dma_i2c1_irq);
+        irq_set_enabled(irq, true);
+    }
+
+    port->on_complete = on_complete;
+}
+
+void ssd1306_dma_start(i2c_inst_t *i2c, uint8_t address, const uint16_t *words, uint count) {
+    ssd1306_dma_port_t *port = &ssd1306_dma_ports[i2c_hw_index(i2c)];
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+
+    // O endereço do escravo só pode ser trocado com o bloco desabilitado (como no SDK)
+    hw->enable = 0;
+    hw->tar = address;
+    hw->enable = 1;
+
+    // Descarta eventos de transações bloqueantes anteriores antes de habilitar a interrupção
+    (void)hw->clr_stop_det;
+    (void)hw->clr_tx_abrt;
+    hw->intr_mask = I2C_IC_INTR_MASK_M_STOP_DET_BITS | I2C_IC_INTR_MASK_M_TX_ABRT_BITS;
+
+    dma_channel_transfer_from_buffer_now(port->channel, words, count);
+}
@@ -0,0 +1,17 @@
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+#ifndef ssd1306_dma_inc_h
+#define ssd1306_dma_inc_h
+
+// Chamada ao fim de cada transferência (em contexto de interrupção); ok é falso se o display não respondeu
+typedef void (*ssd1306_dma_callback_t)(i2c_inst_t *i2c, bool ok);
+
+// Reserva o canal DMA e a interrupção de fim de transferência do barramento
+void ssd1306_dma_init(i2c_inst_t *i2c, ssd1306_dma_callback_t on_complete);
+
+// Inicia o envio (não bloqueante) de palavras no formato do registrador IC_DATA_CMD.
+// O buffer deve permanecer válido até a chamada de on_complete
+void ssd1306_dma_start(i2c_inst_t *i2c, uint8_t address, const uint16_t *words, uint count);
+
+#endif
@@ -0,0 +1,198 @@
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "ssd1306_i2c.h"
+#include "ssd1306_gfx.h"
+
+// Aplica a operação a count bytes consecutivos de uma página, só nos bits de mask
+static inline void ssd1306_gfx_apply(uint8_t *bytes, int count, uint8_t mask, ssd1306_gfx_mode_t mode) {
+    if (mask == 0xFF && mode != SSD1306_GFX_INVERT) {
+        memset(bytes, mode == SSD1306_GFX_SET ? 0xFF : 0x00, count);
+        return;
+    }
+
+    switch (mode) {
+        case SSD1306_GFX_SET:
+            for (int i = 0; i < count; i++) {
+                bytes[i] |= mask;
+            }
+            break;
+        case SSD1306_GFX_CLEAR:
+            for (int i = 0; i < count; i++) {
+                bytes[i] &= ~mask;
+            }
+            break;
+        default:
+            for (int i = 0; i < count; i++) {
+                bytes[i] ^= mask;
+            }
+            break;
+    }
+}
+
+void ssd1306_gfx_clear(uint8_t *ssd, int frame_width, int frame_height, bool set) {
+    int length = frame_width * (frame_height / 8);
+
+    if (((uintptr_t)ssd & 3) == 0) {
+        uint32_t *words = (uint32_t *)ssd;
+        uint32_t value = set ? 0xFFFFFFFFu : 0;
+
+        for (int i = 0; i < length / 4; i++) {
+            words[i] = value;
+        }
+        memset(&ssd[length & ~3], set ? 0xFF : 0x00, length & 3);
+    }
+    else {
+        memset(ssd, set ? 0xFF : 0x00, length);
+    }
+}
+
+void ssd1306_gfx_hspan(uint8_t *ssd, int frame_width, int frame_height,
+                       int x, int y, int width, ssd1306_gfx_mode_t mode) {
+    if (y < 0 || y >= frame_height) {
+        return;
+    }
+    if (x < 0) {
+        width += x;
+        x = 0;
+    }
+    if (x + width > frame_width) {
+        width = frame_width - x;
+    }
+    if (width <= 0) {
+        return;
+    }
+
+    ssd1306_gfx_apply(&ssd[(y >> 3) * frame_width + x], width, 1 << (y & 7), mode);
+}
+
+void ssd1306_gfx_vspan(uint8_t *ssd, int frame_width, int frame_height,
+                       int x, int y, int height, ssd1306_gfx_mode_t mode) {
+    ssd1306_gfx_fill_rect(ssd, frame_width, frame_height, x, y, 1, height, mode);
+}
+
+void ssd1306_gfx_fill_rect(uint8_t *ssd, int frame_width, int frame_height,
+                           int x, int y, int width, int height, ssd1306_gfx_mode_t mode) {
+    // Recorte: [x_0, x_1) x [y_0, y_1)
+    int x_0 = x < 0 ? 0 : x;
+    int y_0 = y < 0 ? 0 : y;
+    int x_1 = x + width > frame_width ? frame_width : x + width;
+    int y_1 = y + height > frame_height ? frame_height : y + height;
+
+    if (x_0 >= x_1 || y_0 >= y_1) {
+        return;
+    }
+
+    int first_page = y_0 >> 3;
+    int last_page = (y_1 - 1) >> 3;
+
+    // Máscaras das páginas das bordas de cima e de baixo; as do meio são inteiras
+    for (int page = first_page; page <= last_page; page++) {
+        uint8_t mask = 0xFF;
+
+        if (page == first_page) {
+            mask &= 0xFF << (y_0 & 7);
+        }
+        if (page == last_page) {
+            mask &= 0xFF >> (7 - ((y_1 - 1) & 7));
+        }
+
+        ssd1306_gfx_apply(&ssd[page * frame_width + x_0], x_1 - x_0, mask, mode);
+    }
+}
+
+void ssd1306_gfx_rect(uint8_t *ssd, int frame_width, int frame_height,
+                      int x, int y, int width, int height, ssd1306_gfx_mode_t mode) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    ssd1306_gfx_hspan(ssd, frame_width, frame_height, x, y, width, mode);
+    if (height > 1) {
+        ssd1306_gfx_hspan(ssd, frame_width, frame_height, x, y + height - 1, width, mode);
+    }
+
+    // Laterais sem os cantos, já desenhados pelas horizontais
+    ssd1306_gfx_vspan(ssd, frame_width, frame_height, x, y + 1, height - 2, mode);
+    if (width > 1) {
+        ssd1306_gfx_vspan(ssd, frame_width, frame_height, x + width - 1, y + 1, height - 2, mode);
+    }
+}
+
+void ssd1306_gfx_invert_rect(uint8_t *ssd, int frame_width, int frame_height, int x, int y, int width, int height) {
+    ssd1306_gfx_fill_rect(ssd, frame_width, frame_height, x, y, width, height, SSD1306_GFX_INVERT);
+}
+
+// Mesmo traçado de ssd1306_draw_line, sem assert nem divisão por pixel: o byte e o bit do ponto atual
+// avançam junto com o Bresenham, e a operação é aplicada sem desvios (apaga os bits de clear_bits e
+// inverte os de flip_bits). Linhas inteiramente de um lado da tela são descartadas de imediato; como a
+// tela é convexa, o traçado termina assim que sai dela depois de ter entrado
+void ssd1306_gfx_line(uint8_t *ssd, int frame_width, int frame_height,
+                      int x_0, int y_0, int x_1, int y_1, ssd1306_gfx_mode_t mode) {
+    if ((x_0 < 0 && x_1 < 0) || (y_0 < 0 && y_1 < 0) ||
+        (x_0 >= frame_width && x_1 >= frame_width) || (y_0 >= frame_height && y_1 >= frame_height)) {
+        return;
+    }
+
+    if (y_0 == y_1) {
+        int left = x_0 < x_1 ? x_0 : x_1;
+        ssd1306_gfx_hspan(ssd, frame_width, frame_height, left, y_0, abs(x_1 - x_0) + 1, mode);
+        return;
+    }
+    if (x_0 == x_1) {
+        int top = y_0 < y_1 ? y_0 : y_1;
+        ssd1306_gfx_vspan(ssd, frame_width, frame_height, x_0, top, abs(y_1 - y_0) + 1, mode);
+        return;
+    }
+
+    int dx = abs(x_1 - x_0); // Deslocamentos
+    int dy = -abs(y_1 - y_0);
+    int sx = x_0 < x_1 ? 1 : -1; // Direção de avanço
+    int sy = y_0 < y_1 ? 1 : -1;
+    int error = dx + dy; // Erro acumulado
+    int steps = dx > -dy ? dx : -dy;
+    bool entered = false;
+
+    uint8_t clear_bits = mode == SSD1306_GFX_INVERT ? 0x00 : 0xFF;
+    uint8_t flip_bits = mode == SSD1306_GFX_CLEAR ? 0x00 : 0xFF;
+
+    // Posição no buffer; fora da tela o ponteiro não é usado, só o índice
+    int index = (y_0 >> 3) * frame_width + x_0;
+    uint8_t mask = 1 << (y_0 & 7);
+
+    for (int i = 0; i <= steps; i++) {
+        if ((unsigned)x_0 < (unsigned)frame_width && (unsigned)y_0 < (unsigned)frame_height) {
+            ssd[index] = (ssd[index] & ~(mask & clear_bits)) ^ (mask & flip_bits);
+            entered = true;
+        }
+        else if (entered) {
+            break;
+        }
+
+        int error_2 = 2 * error;
+
+        if (error_2 >= dy) {
+            error += dy;
+            x_0 += sx;
+            index += sx;
+        }
+        if (error_2 <= dx) {
+            error += dx;
+            y_0 += sy;
+            if (sy > 0) {
+                mask <<= 1;
+                if (mask == 0) {
+                    mask = 0x01;
+                    index += frame_width;
+                }
+            }
+            else {
+                mask >>= 1;
+                if (mask == 0) {
+                    mask = 0x80;
+                    index -= frame_width;
+                }
+            }
+        }
+    }
+}
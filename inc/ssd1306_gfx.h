@@ -0,0 +1,45 @@
+#include "pico/stdlib.h"
+#include "ssd1306_i2c.h"
+
+#ifndef ssd1306_gfx_inc_h
+#define ssd1306_gfx_inc_h
+
+// Primitivas gráficas para um quadro de frame_width x frame_height pixels (uma página de 8 linhas por byte,
+// bit 0 em cima; frame_height múltiplo de 8), como o buffer de trás de uma instância ssd1306_t com a geometria
+// dela. Spans e retângulos alteram bytes inteiros com máscaras, em vez de pixel a pixel.
+// Tudo é recortado nas bordas do quadro: coordenadas fora dele não são erro
+
+// Operação aplicada aos pixels
+typedef enum {
+    SSD1306_GFX_CLEAR = 0,              // Apaga
+    SSD1306_GFX_SET = 1,                // Acende
+    SSD1306_GFX_INVERT = 2              // Inverte
+} ssd1306_gfx_mode_t;
+
+// Preenche o quadro inteiro (com palavras de 32 bits quando o buffer está alinhado)
+void ssd1306_gfx_clear(uint8_t *ssd, int frame_width, int frame_height, bool set);
+
+// Linha horizontal de width pixels a partir de (x, y)
+void ssd1306_gfx_hspan(uint8_t *ssd, int frame_width, int frame_height,
+                       int x, int y, int width, ssd1306_gfx_mode_t mode);
+
+// Linha vertical de height pixels a partir de (x, y)
+void ssd1306_gfx_vspan(uint8_t *ssd, int frame_width, int frame_height,
+                       int x, int y, int height, ssd1306_gfx_mode_t mode);
+
+// Contorno de um retângulo (cada pixel é alterado uma única vez, inclusive os cantos)
+void ssd1306_gfx_rect(uint8_t *ssd, int frame_width, int frame_height,
+                      int x, int y, int width, int height, ssd1306_gfx_mode_t mode);
+
+// Retângulo preenchido
+void ssd1306_gfx_fill_rect(uint8_t *ssd, int frame_width, int frame_height,
+                           int x, int y, int width, int height, ssd1306_gfx_mode_t mode);
+
+// Inverte os pixels de um retângulo (por exemplo, para destacar um item)
+void ssd1306_gfx_invert_rect(uint8_t *ssd, int frame_width, int frame_height, int x, int y, int width, int height);
+
+// Linha de Bresenham entre dois pontos quaisquer, desenhando só a parte dentro do quadro
+void ssd1306_gfx_line(uint8_t *ssd, int frame_width, int frame_height,
+                      int x_0, int y_0, int x_1, int y_1, ssd1306_gfx_mode_t mode);
+
+#endif
@@ -1,245 +1,717 @@
-#include <stdio.h>
-#include <string.h>
-#include <stdlib.h>
-#include <ctype.h>
-#include "pico/stdlib.h"
-#include "pico/binary_info.h"
-#include "hardware/i2c.h"
-#include "ssd1306_font.h"
-#include "ssd1306_i2c.h"
-
-// Calcular quanto do buffer será destinado à área de renderização
-void calculate_render_area_buffer_length(struct render_area *area) {
-    area->buffer_length = (area->end_column - area->start_column + 1) * (area->end_page - area->start_page + 1);
-}
-
-// Processo de escrita do i2c espera um byte de controle, seguido por dados
-void ssd1306_send_command(uint8_t command) {
-    uint8_t buffer[2] = {0x80, command};
-    i2c_write_blocking(i2c1, ssd1306_i2c_address, buffer, 2, false);
-}
-
-// Envia uma lista de comandos ao hardware
-void ssd1306_send_command_list(uint8_t *ssd, int number) {
-    for (int i = 0; i < number; i++) {
-        ssd1306_send_command(ssd[i]);
-    }
-}
-
-// Copia buffer de referência num novo buffer, a fim de adicionar o byte de controle desde o início
-void ssd1306_send_buffer(uint8_t ssd[], int buffer_length) {
-    uint8_t *temp_buffer = malloc(buffer_length + 1);
-
-    temp_buffer[0] = 0x40;
-    memcpy(temp_buffer + 1, ssd, buffer_length);
-
-    i2c_write_blocking(i2c1, ssd1306_i2c_address, temp_buffer, buffer_length + 1, false);
-
-    free(temp_buffer);
-}
-
-// Cria a lista de comandos (com base nos endereços definidos em ssd1306_i2c.h) para a inicialização do display
-void ssd1306_init() {
-    uint8_t commands[] = {
-        ssd1306_set_display, ssd1306_set_memory_mode, 0x00,
-        ssd1306_set_display_start_line, ssd1306_set_segment_remap | 0x01, 
-        ssd1306_set_mux_ratio, ssd1306_height - 1,
-        ssd1306_set_common_output_direction | 0x08, ssd1306_set_display_offset,
-        0x00, ssd1306_set_common_pin_configuration,
-    
-#if ((ssd1306_width == 128) && (ssd1306_height == 32))
-    0x02,
-#elif ((ssd1306_width == 128) && (ssd1306_height == 64))
-    0x12,
-#else
-    0x02,
-#endif
-        ssd1306_set_display_clock_divide_ratio, 0x80, ssd1306_set_precharge,
-        0xF1, ssd1306_set_vcomh_deselect_level, 0x30, ssd1306_set_contrast,
-        0xFF, ssd1306_set_entire_on, ssd1306_set_normal_display,
-        ssd1306_set_charge_pump, 0x14, ssd1306_set_scroll | 0x00,
-        ssd1306_set_display | 0x01,
-    };
-
-    ssd1306_send_command_list(commands, count_of(commands));
-}
-
-// Cria a lista de comandos para configurar o scrolling
-void ssd1306_scroll(bool set) {
-    uint8_t commands[] = {
-        ssd1306_set_horizontal_scroll | 0x00, 0x00, 0x00, 0x00, 0x03,
-        0x00, 0xFF, ssd1306_set_scroll | (set ? 0x01 : 0)
-    };
-
-    ssd1306_send_command_list(commands, count_of(commands));
-}
-
-// Atualiza uma parte do display com uma área de renderização
-void render_on_display(uint8_t *ssd, struct render_area *area) {
-    uint8_t commands[] = {
-        ssd1306_set_column_address, area->start_column, area->end_column,
-        ssd1306_set_page_address, area->start_page, area->end_page
-    };
-
-    ssd1306_send_command_list(commands, count_of(commands));
-    ssd1306_send_buffer(ssd, area->buffer_length);
-}
-
-// Determina o pixel a ser aceso (no display) de acordo com a coordenada fornecida
-void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set) {
-    assert(x >= 0 && x < ssd1306_width && y >= 0 && y < ssd1306_height);
-
-    const int bytes_per_row = ssd1306_width;
-
-    int byte_idx = (y / 8) * bytes_per_row + x;
-    uint8_t byte = ssd[byte_idx];
-
-    if (set) {
-        byte |= 1 << (y % 8);
-    }
-    else {
-        byte &= ~(1 << (y % 8));
-    }
-
-    ssd[byte_idx] = byte;
-}
-
-// Algoritmo de Bresenham básico
-void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set) {
-    int dx = abs(x_1 - x_0); // Deslocamentos
-    int dy = -abs(y_1 - y_0);
-    int sx = x_0 < x_1 ? 1 : -1; // Direção de avanço
-    int sy = y_0 < y_1 ? 1 : -1;
-    int error = dx + dy; // Erro acumulado
-    int error_2;
-
-    while (true) {
-        ssd1306_set_pixel(ssd, x_0, y_0, set); // Acende pixel no ponto atual
-        if (x_0 == x_1 && y_0 == y_1) {
-            break; // Verifica se o ponto final foi alcançado
-        }
-
-        error_2 = 2 * error; // Ajusta o erro acumulado
-
-        if (error_2 >= dy) {
-            error += dy;
-            x_0 += sx; // Avança na direção x
-        }
-        if (error_2 <= dx) {
-            error += dx;
-            y_0 += sy; // Avança na direção y
-        }
-    }
-}
-
-// Adquire os pixels para um caractere (de acordo com ssd1306_font.h)
-inline int ssd1306_get_font(uint8_t character)
-{
-  if (character >= 'A' && character <= 'Z') {
-    return character - 'A' + 1;
-  }
-  else if (character >= '0' && character <= '9') {
-    return character - '0' + 27;
-  }
-  else
-    return 0;
-}
-
-// Desenha um único caractere no display
-void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character) {
-    if (x > ssd1306_width - 8 || y > ssd1306_height - 8) {
-        return;
-    }
-
-    y = y / 8;
-
-    character = toupper(character);
-    int idx = ssd1306_get_font(character);
-    int fb_idx = y * 128 + x;
-
-    for (int i = 0; i < 8; i++) {
-        ssd[fb_idx++] = font[idx * 8 + i];
-    }
-}
-
-// Desenha uma string, chamando a função de desenhar caractere várias vezes
-void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string) {
-    if (x > ssd1306_width - 8 || y > ssd1306_height - 8) {
-        return;
-    }
-
-    while (*string) {
-        ssd1306_draw_char(ssd, x, y, *string++);
-        x += 8;
-    }
-}
-
-// Comando de configuração com base na estrutura ssd1306_t
-void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
-  ssd->port_buffer[1] = command;
-  i2c_write_blocking(
-	ssd->i2c_port, ssd->address, ssd->port_buffer, 2, false );
-}
-
-// Função de configuração do display para o caso do bitmap
-void ssd1306_config(ssd1306_t *ssd) {
-    ssd1306_command(ssd, ssd1306_set_display | 0x00);
-    ssd1306_command(ssd, ssd1306_set_memory_mode);
-    ssd1306_command(ssd, 0x01);
-    ssd1306_command(ssd, ssd1306_set_display_start_line | 0x00);
-    ssd1306_command(ssd, ssd1306_set_segment_remap | 0x01);
-    ssd1306_command(ssd, ssd1306_set_mux_ratio);
-    ssd1306_command(ssd, ssd1306_height - 1);
-    ssd1306_command(ssd, ssd1306_set_common_output_direction | 0x08);
-    ssd1306_command(ssd, ssd1306_set_display_offset);
-    ssd1306_command(ssd, 0x00);
-    ssd1306_command(ssd, ssd1306_set_common_pin_configuration);
-    ssd1306_command(ssd, 0x12);
-    ssd1306_command(ssd, ssd1306_set_display_clock_divide_ratio);
-    ssd1306_command(ssd, 0x80);
-    ssd1306_command(ssd, ssd1306_set_precharge);
-    ssd1306_command(ssd, 0xF1);
-    ssd1306_command(ssd, ssd1306_set_vcomh_deselect_level);
-    ssd1306_command(ssd, 0x30);
-    ssd1306_command(ssd, ssd1306_set_contrast);
-    ssd1306_command(ssd, 0xFF);
-    ssd1306_command(ssd, ssd1306_set_entire_on);
-    ssd1306_command(ssd, ssd1306_set_normal_display);
-    ssd1306_command(ssd, ssd1306_set_charge_pump);
-    ssd1306_command(ssd, 0x14);
-    ssd1306_command(ssd, ssd1306_set_display | 0x01);
-}
-
-// Inicializa o display para o caso de exibição de bitmap
-void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
-    ssd->width = width;
-    ssd->height = height;
-    ssd->pages = height / 8U;
-    ssd->address = address;
-    ssd->i2c_port = i2c;
-    ssd->bufsize = ssd->pages * ssd->width + 1;
-    ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
-    ssd->ram_buffer[0] = 0x40;
-    ssd->port_buffer[0] = 0x80;
-}
-
-// Envia os dados ao display
-void ssd1306_send_data(ssd1306_t *ssd) {
-    ssd1306_command(ssd, ssd1306_set_column_address);
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->width - 1);
-    ssd1306_command(ssd, ssd1306_set_page_address);
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->pages - 1);
-    i2c_write_blocking(
-    ssd->i2c_port, ssd->address, ssd->ram_buffer, ssd->bufsize, false );
-}
-
-// Desenha o bitmap (a ser fornecido em display_oled.c) no display
-void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap) {
-    for (int i = 0; i < ssd->bufsize - 1; i++) {
-        ssd->ram_buffer[i + 1] = bitmap[i];
-
-        ssd1306_send_data(ssd);
-    }
-}
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "pico/stdlib.h"
+#include "pico/binary_info.h"
+#include "hardware/i2c.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "ssd1306_font.h"
+#include "ssd1306_i2c.h"
+#include "ssd1306.h"
+#include "ssd1306_dma.h"
+
+// Display padrão (i2c1, ssd1306_i2c_address), usado pelas funções sem parâmetro ssd1306_t
+SSD1306_STORAGE(ssd1306_default, ssd1306_width, ssd1306_height);
+static ssd1306_t ssd1306_default;
+
+// Instância com envio por DMA em cada barramento (i2c0 e i2c1), para a interrupção de fim de transferência
+static ssd1306_t *ssd1306_bus_displays[2];
+
+// Escrita bloqueante contabilizada nos contadores de tráfego da instância
+static int ssd1306_i2c_write(ssd1306_t *ssd, const uint8_t *src, size_t length) {
+    ssd->bus_stats.transactions++;
+    ssd->bus_stats.bytes += length;
+    return i2c_write_blocking(ssd->i2c_port, ssd->address, src, length, false);
+}
+
+// Copia os contadores de tráfego desde a última chamada a ssd1306_display_reset_bus_stats
+void ssd1306_display_get_bus_stats(ssd1306_t *ssd, ssd1306_bus_stats_t *stats) {
+    *stats = ssd->bus_stats;
+}
+
+void ssd1306_display_reset_bus_stats(ssd1306_t *ssd) {
+    ssd->bus_stats.transactions = 0;
+    ssd->bus_stats.bytes = 0;
+}
+
+// Calcular quanto do buffer será destinado à área de renderização
+void calculate_render_area_buffer_length(struct render_area *area) {
+    area->buffer_length = (area->end_column - area->start_column + 1) * (area->end_page - area->start_page + 1);
+}
+
+// Fim da transferência por DMA (contexto de interrupção)
+static void ssd1306_transfer_done(i2c_inst_t *i2c, bool ok) {
+    ssd1306_t *ssd = ssd1306_bus_displays[i2c_hw_index(i2c)];
+    BaseType_t woken = pdFALSE;
+    uint32_t transfer_us = (uint32_t)(time_us_64() - ssd->tx_start_us);
+
+    ssd->frame_stats.last_transfer_us = transfer_us;
+    if (transfer_us > ssd->frame_stats.max_transfer_us) {
+        ssd->frame_stats.max_transfer_us = transfer_us;
+    }
+
+    ssd->tx_ok = ok;
+    ssd->tx_busy = false;
+
+    xSemaphoreGiveFromISR(ssd->tx_idle, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+// Aguarda a transferência em andamento da instância; retorna falso em caso de timeout ou de erro no barramento.
+// Qualquer tarefa pode esperar, não só a que iniciou o envio: quem recebe o semáforo de fim de envio o devolve
+// em seguida, acordando a próxima tarefa que espera
+bool ssd1306_display_wait(ssd1306_t *ssd, TickType_t timeout) {
+    if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
+        // Antes do escalonador nenhuma tarefa pode bloquear
+        while (ssd->tx_busy) {
+            tight_loop_contents();
+        }
+    }
+    else {
+        TimeOut_t start;
+
+        vTaskSetTimeOutState(&start);
+        while (ssd->tx_busy && xTaskCheckForTimeOut(&start, &timeout) == pdFALSE) {
+            // Um semáforo devolvido depois do início do envio seguinte é velho: fica consumido e a espera continua
+            if (xSemaphoreTake(ssd->tx_idle, timeout) == pdTRUE && !ssd->tx_busy) {
+                xSemaphoreGive(ssd->tx_idle);
+            }
+        }
+    }
+
+    return !ssd->tx_busy && ssd->tx_ok;
+}
+
+// Dispara o DMA com os buffer_length bytes de pixel já copiados para tx_words
+static void ssd1306_start_transfer(ssd1306_t *ssd, int buffer_length) {
+    // O registrador IC_DATA_CMD recebe 16 bits por byte; o STOP vai junto do último
+    ssd->tx_words[buffer_length] |= I2C_IC_DATA_CMD_STOP_BITS;
+
+    xSemaphoreTake(ssd->tx_idle, 0);    // O barramento deixa de estar livre até a próxima conclusão
+
+    ssd->bus_stats.transactions++;
+    ssd->bus_stats.bytes += buffer_length + 1;
+
+    ssd->tx_busy = true;
+    ssd->tx_start_us = time_us_64();
+    ssd1306_dma_start(ssd->i2c_port, ssd->address, ssd->tx_words, buffer_length + 1);
+}
+
+// Inicia o envio do buffer por DMA e retorna imediatamente; o conteúdo de buffer pode ser reutilizado em seguida
+void ssd1306_display_send_async(ssd1306_t *ssd, const uint8_t *buffer, int buffer_length) {
+    if (buffer_length <= 0) {
+        return;
+    }
+
+    configASSERT(ssd->tx_words != NULL && buffer_length <= (int)ssd->bufsize - 1);
+    ssd1306_display_wait(ssd, portMAX_DELAY);
+
+    for (int i = 0; i < buffer_length; i++) {
+        ssd->tx_words[i + 1] = buffer[i];
+    }
+    ssd1306_start_transfer(ssd, buffer_length);
+}
+
+// Envia o buffer precedido do byte de controle, bloqueando a tarefa (sem ocupar a CPU) até o fim
+void ssd1306_display_send(ssd1306_t *ssd, const uint8_t *buffer, int buffer_length) {
+    ssd1306_display_send_async(ssd, buffer, buffer_length);
+    ssd1306_display_wait(ssd, portMAX_DELAY);
+}
+
+// Comando de configuração com base na estrutura ssd1306_t; o barramento pode estar ocupado pelo DMA
+void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+    ssd1306_display_wait(ssd, portMAX_DELAY);
+
+    ssd->port_buffer[1] = command;
+    ssd1306_i2c_write(ssd, ssd->port_buffer, 2);
+}
+
+// Envia uma lista de comandos em uma única transação: o byte de controle 0x00 (Co = 0)
+// indica ao display que todos os bytes seguintes até o STOP são comandos
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, int number) {
+    uint8_t buffer[SSD1306_MAX_COMMAND_LIST + 1];
+
+    ssd1306_display_wait(ssd, portMAX_DELAY);
+
+    buffer[0] = 0x00;
+    while (number > 0) {
+        int chunk = number < SSD1306_MAX_COMMAND_LIST ? number : SSD1306_MAX_COMMAND_LIST;
+
+        memcpy(&buffer[1], commands, chunk);
+        ssd1306_i2c_write(ssd, buffer, chunk + 1);
+
+        commands += chunk;
+        number -= chunk;
+    }
+}
+
+// Campos comuns às duas formas de inicialização
+static void ssd1306_setup(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+    memset(ssd, 0, sizeof(*ssd));
+    ssd->width = width;
+    ssd->height = height;
+    ssd->pages = height / 8U;
+    ssd->address = address;
+    ssd->i2c_port = i2c;
+    ssd->external_vcc = external_vcc;
+    ssd->bufsize = SSD1306_BM_BUFFER_SIZE(width, height);
+    ssd->port_buffer[0] = 0x80;
+    ssd->tx_ok = true;
+}
+
+// Inicializa uma instância com double buffer e envio por DMA, com a memória de SSD1306_STORAGE
+// (use SSD1306_INIT_DISPLAY). Cada barramento comporta uma instância dessas; instâncias em barramentos
+// diferentes enviam seus quadros ao mesmo tempo, cada uma com seu canal DMA
+void ssd1306_init_display(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c,
+                          uint8_t *frames, uint16_t *tx_words, StaticSemaphore_t *tx_idle) {
+    uint index = i2c_hw_index(i2c);
+    size_t stride = SSD1306_FRAME_STRIDE(width, height);
+    SemaphoreHandle_t idle = NULL;
+
+    configASSERT(ssd1306_bus_displays[index] == NULL || ssd1306_bus_displays[index] == ssd);
+    // Uma reinicialização não pode descartar um envio em andamento, e mantém o semáforo já criado
+    if (ssd1306_bus_displays[index] == ssd) {
+        ssd1306_display_wait(ssd, portMAX_DELAY);
+        idle = ssd->tx_idle;
+    }
+
+    ssd1306_setup(ssd, width, height, external_vcc, address, i2c);
+
+    if (idle == NULL) {
+#if configSUPPORT_STATIC_ALLOCATION
+        idle = xSemaphoreCreateBinaryStatic(tx_idle);
+#else
+        idle = xSemaphoreCreateBinary();
+#endif
+        configASSERT(idle != NULL);
+        xSemaphoreGive(idle);           // Barramento livre
+    }
+    ssd->tx_idle = idle;
+
+    // Cada quadro é precedido pelo byte de controle 0x40, de modo que ram_buffer sempre aponta para o
+    // buffer de trás no formato da API de bitmap; o deslocamento de 4 bytes mantém os pixels alinhados
+    memset(frames, 0, 2 * stride);
+    frames[3] = 0x40;
+    frames[stride + 3] = 0x40;
+    ssd->front = &frames[4];
+    ssd->ram_buffer = &frames[stride + 3];
+
+    ssd->tx_words = tx_words;
+    ssd->tx_words[0] = 0x40;
+
+    ssd1306_bus_displays[index] = ssd;
+    ssd1306_dma_init(i2c, ssd1306_transfer_done);
+}
+
+// Inicializa o ssd1306_t com um buffer fornecido pelo chamador, de SSD1306_BM_BUFFER_SIZE(width, height) bytes
+// (por exemplo um vetor estático), sem alocação dinâmica. Sem double buffer, os envios são bloqueantes
+void ssd1306_init_bm_buffer(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c, uint8_t *buffer) {
+    ssd1306_setup(ssd, width, height, external_vcc, address, i2c);
+    ssd->ram_buffer = buffer;
+    memset(ssd->ram_buffer, 0, ssd->bufsize);
+    ssd->ram_buffer[0] = 0x40;
+}
+
+#if configSUPPORT_DYNAMIC_ALLOCATION
+// Mesma inicialização, com o buffer alocado no heap. Indisponível no perfil estático (REFLEX_STATIC_ALLOC)
+void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+    uint8_t *buffer = malloc(SSD1306_BM_BUFFER_SIZE(width, height));
+
+    ssd1306_init_bm_buffer(ssd, width, height, external_vcc, address, i2c, buffer);
+}
+#endif
+
+// Envia ao display a sequência de inicialização, de acordo com a geometria e a alimentação da instância
+void ssd1306_config(ssd1306_t *ssd) {
+    uint8_t commands[] = {
+        ssd1306_set_display | 0x00,
+        ssd1306_set_memory_mode, 0x00, // Horizontal: janelas são preenchidas página por página, como o buffer
+        ssd1306_set_display_start_line | 0x00,
+        ssd1306_set_segment_remap | 0x01,
+        ssd1306_set_mux_ratio, ssd->height - 1,
+        ssd1306_set_common_output_direction | 0x08,
+        ssd1306_set_display_offset, 0x00,
+        ssd1306_set_common_pin_configuration, (ssd->width == 128 && ssd->height == 32) ? 0x02 : 0x12,
+        ssd1306_set_display_clock_divide_ratio, 0x80,
+        ssd1306_set_precharge, ssd->external_vcc ? 0x22 : 0xF1,
+        ssd1306_set_vcomh_deselect_level, 0x30,
+        ssd1306_set_contrast, 0xFF,
+        ssd1306_set_entire_on,
+        ssd1306_set_normal_display,
+        ssd1306_set_charge_pump, ssd->external_vcc ? 0x10 : 0x14,
+        ssd1306_set_scroll | 0x00,
+        ssd1306_set_display | 0x01,
+    };
+
+    ssd1306_command_list(ssd, commands, count_of(commands));
+
+    // A RAM do display não é conhecida após a inicialização
+    ssd->front_valid = false;
+}
+
+// Cria a lista de comandos para configurar o scrolling
+void ssd1306_display_scroll(ssd1306_t *ssd, bool set) {
+    uint8_t commands[] = {
+        ssd1306_set_horizontal_scroll | 0x00, 0x00, 0x00, 0x00, 0x03,
+        0x00, 0xFF, ssd1306_set_scroll | (set ? 0x01 : 0)
+    };
+
+    ssd1306_command_list(ssd, commands, count_of(commands));
+}
+
+// Aguarda o envio em andamento. Se ele (ou o último envio) falhou, o quadro retido tem pixels que o display
+// não recebeu e deixa de valer: o próximo envio por diferenças manda o quadro inteiro
+static void ssd1306_wait_front(ssd1306_t *ssd) {
+    if (!ssd1306_display_wait(ssd, portMAX_DELAY)) {
+        ssd->front_valid = false;
+    }
+}
+
+// Copia uma janela (página por página, em ordem de envio) de um buffer compacto para o quadro da frente
+static void ssd1306_update_front(ssd1306_t *ssd, const uint8_t *buffer, const struct render_area *area) {
+    if (ssd->front == NULL) {
+        return;
+    }
+
+    int area_width = area->end_column - area->start_column + 1;
+    for (int page = area->start_page; page <= area->end_page; page++) {
+        memcpy(&ssd->front[page * ssd->width + area->start_column], buffer, area_width);
+        buffer += area_width;
+    }
+
+    if (area->start_column == 0 && area->end_column == ssd->width - 1 &&
+        area->start_page == 0 && area->end_page == ssd->pages - 1) {
+        ssd->front_valid = true;
+    }
+}
+
+// Atualiza uma parte do display com uma área de renderização
+void ssd1306_display_render(ssd1306_t *ssd, const uint8_t *buffer, struct render_area *area) {
+    uint8_t commands[] = {
+        ssd1306_set_column_address, area->start_column, area->end_column,
+        ssd1306_set_page_address, area->start_page, area->end_page
+    };
+
+    ssd1306_wait_front(ssd);
+    ssd1306_command_list(ssd, commands, count_of(commands));
+    ssd1306_display_send_async(ssd, buffer, area->buffer_length);
+
+    // Mantém a cópia retida coerente com o que foi enviado
+    ssd1306_update_front(ssd, buffer, area);
+}
+
+// Envia apenas as janelas (colunas de cada página) que diferem do que o display já exibe.
+// Recebe um quadro completo e retorna quantos bytes de pixel foram enviados
+int ssd1306_display_render_changes(ssd1306_t *ssd, const uint8_t *buffer) {
+    configASSERT(ssd->front != NULL);
+
+    ssd1306_wait_front(ssd);
+    if (!ssd->front_valid) {
+        struct render_area frame_area = {
+            .start_column = 0,
+            .end_column = ssd->width - 1,
+            .start_page = 0,
+            .end_page = ssd->pages - 1
+        };
+
+        calculate_render_area_buffer_length(&frame_area);
+        ssd1306_display_render(ssd, buffer, &frame_area);
+        return frame_area.buffer_length;
+    }
+
+    int sent = 0;
+
+    for (int page = 0; page < ssd->pages; page++) {
+        const uint8_t *row = &buffer[page * ssd->width];
+        const uint8_t *front_row = &ssd->front[page * ssd->width];
+
+        int first = 0;
+        while (first < ssd->width && row[first] == front_row[first]) {
+            first++;
+        }
+        if (first == ssd->width) {
+            continue; // Página inalterada
+        }
+
+        int last = ssd->width - 1;
+        while (row[last] == front_row[last]) {
+            last--;
+        }
+
+        struct render_area page_area = {
+            .start_column = first,
+            .end_column = last,
+            .start_page = page,
+            .end_page = page
+        };
+
+        calculate_render_area_buffer_length(&page_area);
+        ssd1306_display_render(ssd, &row[first], &page_area);
+        sent += page_area.buffer_length;
+    }
+
+    return sent;
+}
+
+// Buffer (quadro completo, width * pages bytes) onde o próximo quadro deve ser desenhado; é o mesmo
+// ram_buffer da API de bitmap, sem o byte de controle. Após cada flip ele começa com o conteúdo do
+// quadro publicado, então basta desenhar o que mudou
+uint8_t *ssd1306_display_back_buffer(ssd1306_t *ssd) {
+    return &ssd->ram_buffer[1];
+}
+
+// Publica o quadro desenhado no buffer de trás: aguarda o fim do envio anterior, inicia por DMA o envio
+// da menor janela que contém todas as mudanças e troca os buffers. Retorna sem esperar o envio, de modo
+// que o próximo quadro já pode ser desenhado; retorna quantos bytes de pixel foram enviados
+int ssd1306_display_flip(ssd1306_t *ssd) {
+    configASSERT(ssd->front != NULL);
+
+    uint8_t *back = &ssd->ram_buffer[1];
+    uint64_t now = time_us_64();
+
+    if (ssd->frame_stats.frames + ssd->frame_stats.unchanged > 0) {
+        uint32_t interval_us = (uint32_t)(now - ssd->last_flip_us);
+
+        ssd->frame_stats.last_interval_us = interval_us;
+        if (ssd->frame_stats.min_interval_us == 0 || interval_us < ssd->frame_stats.min_interval_us) {
+            ssd->frame_stats.min_interval_us = interval_us;
+        }
+        if (interval_us > ssd->frame_stats.max_interval_us) {
+            ssd->frame_stats.max_interval_us = interval_us;
+        }
+    }
+    ssd->last_flip_us = now;
+
+    // O quadro da frente só pode deixar de ser a referência depois que terminou de sair pelo barramento
+    ssd1306_wait_front(ssd);
+
+    struct render_area area = {
+        .start_column = 0,
+        .end_column = ssd->width - 1,
+        .start_page = 0,
+        .end_page = ssd->pages - 1
+    };
+
+    if (ssd->front_valid) {
+        int first_column = ssd->width, last_column = -1;
+        int first_page = -1, last_page = -1;
+
+        for (int page = 0; page < ssd->pages; page++) {
+            const uint8_t *row = &back[page * ssd->width];
+            const uint8_t *front_row = &ssd->front[page * ssd->width];
+
+            int first = 0;
+            while (first < ssd->width && row[first] == front_row[first]) {
+                first++;
+            }
+            if (first == ssd->width) {
+                continue; // Página inalterada
+            }
+
+            int last = ssd->width - 1;
+            while (row[last] == front_row[last]) {
+                last--;
+            }
+
+            if (first_page < 0) {
+                first_page = page;
+            }
+            last_page = page;
+            first_column = first < first_column ? first : first_column;
+            last_column = last > last_column ? last : last_column;
+        }
+
+        if (first_page < 0) {
+            ssd->frame_stats.unchanged++;
+            return 0;
+        }
+
+        area.start_column = first_column;
+        area.end_column = last_column;
+        area.start_page = first_page;
+        area.end_page = last_page;
+    }
+
+    calculate_render_area_buffer_length(&area);
+
+    uint8_t commands[] = {
+        ssd1306_set_column_address, area.start_column, area.end_column,
+        ssd1306_set_page_address, area.start_page, area.end_page
+    };
+
+    ssd1306_command_list(ssd, commands, count_of(commands));
+
+    // Copia a janela, página por página, direto do quadro para as palavras lidas pelo DMA
+    int area_width = area.end_column - area.start_column + 1;
+    uint16_t *word = &ssd->tx_words[1];
+    for (int page = area.start_page; page <= area.end_page; page++) {
+        const uint8_t *row = &back[page * ssd->width + area.start_column];
+
+        for (int i = 0; i < area_width; i++) {
+            *word++ = row[i];
+        }
+    }
+    ssd1306_start_transfer(ssd, area.buffer_length);
+
+    // Troca os papéis; o novo buffer de trás só difere do quadro publicado dentro da janela enviada
+    uint8_t *published = back;
+    back = ssd->front;
+    ssd->front = published;
+    ssd->ram_buffer = back - 1;
+    for (int page = area.start_page; page <= area.end_page; page++) {
+        int offset = page * ssd->width + area.start_column;
+        memcpy(&back[offset], &ssd->front[offset], area_width);
+    }
+
+    ssd->front_valid = true;
+    ssd->frame_stats.frames++;
+    return area.buffer_length;
+}
+
+// Copia o ritmo dos quadros desde a última chamada a ssd1306_display_reset_frame_stats
+void ssd1306_display_get_frame_stats(ssd1306_t *ssd, ssd1306_frame_stats_t *stats) {
+    *stats = ssd->frame_stats;
+}
+
+void ssd1306_display_reset_frame_stats(ssd1306_t *ssd) {
+    memset(&ssd->frame_stats, 0, sizeof(ssd->frame_stats));
+}
+
+// Envia ao display o buffer inteiro da API de bitmap (bloqueante)
+void ssd1306_send_data(ssd1306_t *ssd) {
+    uint8_t commands[] = {
+        ssd1306_set_column_address, 0, ssd->width - 1,
+        ssd1306_set_page_address, 0, ssd->pages - 1
+    };
+
+    ssd1306_command_list(ssd, commands, count_of(commands));
+    ssd1306_i2c_write(ssd, ssd->ram_buffer, ssd->bufsize);
+
+    if (ssd->front != NULL) {
+        memcpy(ssd->front, &ssd->ram_buffer[1], ssd->bufsize - 1);
+        ssd->front_valid = true;
+    }
+}
+
+// Envia só uma janela de colunas/páginas do buffer. Cada linha de página já é contígua no buffer: o byte
+// anterior a ela é trocado temporariamente pelo byte de controle 0x40, sem copiar os pixels.
+// Se a janela ocupa a largura toda, as páginas são contíguas e vão numa única transação
+void ssd1306_send_area(ssd1306_t *ssd, const struct render_area *area) {
+    uint8_t commands[] = {
+        ssd1306_set_column_address, area->start_column, area->end_column,
+        ssd1306_set_page_address, area->start_page, area->end_page
+    };
+    int area_width = area->end_column - area->start_column + 1;
+    int rows = area->end_page - area->start_page + 1;
+    int row_length = area_width;
+
+    if (area_width == ssd->width) {
+        row_length *= rows;
+        rows = 1;
+    }
+
+    ssd1306_command_list(ssd, commands, count_of(commands));
+
+    for (int row = 0; row < rows; row++) {
+        uint8_t *control = &ssd->ram_buffer[(area->start_page + row) * ssd->width + area->start_column];
+        uint8_t saved = *control;
+
+        *control = 0x40;
+        ssd1306_i2c_write(ssd, control, row_length + 1);
+        *control = saved;
+    }
+
+    // A janela enviada passa a fazer parte do quadro retido
+    if (ssd->front != NULL) {
+        for (int page = area->start_page; page <= area->end_page; page++) {
+            int offset = page * ssd->width + area->start_column;
+            memcpy(&ssd->front[offset], &ssd->ram_buffer[offset + 1], area_width);
+        }
+    }
+}
+
+// Desenha o bitmap (a ser fornecido em display_oled.c, no formato do buffer) no display, com um único envio
+void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap) {
+    memcpy(&ssd->ram_buffer[1], bitmap, ssd->bufsize - 1);
+    ssd1306_send_data(ssd);
+}
+
+// --- Display padrão ---
+// As funções abaixo mantêm a API original (quadros de ssd1306_buffer_length bytes) sobre a instância
+// ssd1306_default, no i2c1 e em ssd1306_i2c_address
+
+ssd1306_t *ssd1306_get_default(void) {
+    return &ssd1306_default;
+}
+
+// Inicializa a instância padrão e envia a sequência de inicialização; o i2c1 já deve estar configurado
+void ssd1306_init() {
+    SSD1306_INIT_DISPLAY(&ssd1306_default, ssd1306_default, ssd1306_width, ssd1306_height, false, ssd1306_i2c_address, i2c1);
+    ssd1306_config(&ssd1306_default);
+}
+
+void ssd1306_get_bus_stats(ssd1306_bus_stats_t *stats) {
+    ssd1306_display_get_bus_stats(&ssd1306_default, stats);
+}
+
+void ssd1306_reset_bus_stats(void) {
+    ssd1306_display_reset_bus_stats(&ssd1306_default);
+}
+
+bool ssd1306_wait_transfer(TickType_t timeout) {
+    return ssd1306_display_wait(&ssd1306_default, timeout);
+}
+
+void ssd1306_send_buffer_async(uint8_t ssd[], int buffer_length) {
+    ssd1306_display_send_async(&ssd1306_default, ssd, buffer_length);
+}
+
+void ssd1306_send_buffer(uint8_t ssd[], int buffer_length) {
+    ssd1306_display_send(&ssd1306_default, ssd, buffer_length);
+}
+
+void ssd1306_send_command(uint8_t command) {
+    ssd1306_command(&ssd1306_default, command);
+}
+
+void ssd1306_send_command_list(uint8_t *ssd, int number) {
+    ssd1306_command_list(&ssd1306_default, ssd, number);
+}
+
+void ssd1306_scroll(bool set) {
+    ssd1306_display_scroll(&ssd1306_default, set);
+}
+
+void render_on_display(uint8_t *ssd, struct render_area *area) {
+    ssd1306_display_render(&ssd1306_default, ssd, area);
+}
+
+int render_changes_on_display(uint8_t *ssd) {
+    return ssd1306_display_render_changes(&ssd1306_default, ssd);
+}
+
+uint8_t *ssd1306_back_buffer(void) {
+    return ssd1306_display_back_buffer(&ssd1306_default);
+}
+
+int ssd1306_flip(void) {
+    return ssd1306_display_flip(&ssd1306_default);
+}
+
+void ssd1306_get_frame_stats(ssd1306_frame_stats_t *stats) {
+    ssd1306_display_get_frame_stats(&ssd1306_default, stats);
+}
+
+void ssd1306_reset_frame_stats(void) {
+    ssd1306_display_reset_frame_stats(&ssd1306_default);
+}
+
+// Determina o pixel a ser aceso (no display) de acordo com a coordenada fornecida
+void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set) {
+    assert(x >= 0 && x < ssd1306_width && y >= 0 && y < ssd1306_height);
+
+    const int bytes_per_row = ssd1306_width;
+
+    int byte_idx = (y / 8) * bytes_per_row + x;
+    uint8_t byte = ssd[byte_idx];
+
+    if (set) {
+        byte |= 1 << (y % 8);
+    }
+    else {
+        byte &= ~(1 << (y % 8));
+    }
+
+    ssd[byte_idx] = byte;
+}
+
+// Algoritmo de Bresenham básico
+void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set) {
+    int dx = abs(x_1 - x_0); // Deslocamentos
+    int dy = -abs(y_1 - y_0);
+    int sx = x_0 < x_1 ? 1 : -1; // Direção de avanço
+    int sy = y_0 < y_1 ? 1 : -1;
+    int error = dx + dy; // Erro acumulado
+    int error_2;
+
+    while (true) {
+        ssd1306_set_pixel(ssd, x_0, y_0, set); // Acende pixel no ponto atual
+        if (x_0 == x_1 && y_0 == y_1) {
+            break; // Verifica se o ponto final foi alcançado
+        }
+
+        error_2 = 2 * error; // Ajusta o erro acumulado
+
+        if (error_2 >= dy) {
+            error += dy;
+            x_0 += sx; // Avança na direção x
+        }
+        if (error_2 <= dx) {
+            error += dx;
+            y_0 += sy; // Avança na direção y
+        }
+    }
+}
+
+// Adquire os pixels para um caractere (de acordo com ssd1306_font.h, gerado de assets/font_8x8.bdf): um acesso
+// direto a font_index, sem comparações; caracteres fora da fonte viram espaço
+static inline int ssd1306_get_font(uint8_t character)
+{
+  return font_index[character];
+}
+
+// Desenha um único caractere num quadro de frame_width x frame_height pixels, em qualquer posição (inclusive
+// parcialmente fora dele). Cada coluna do caractere é deslocada para a linha y como uma palavra de 16 bits que
+// cobre duas páginas; a máscara substitui só os 8 pixels do caractere e preserva o restante das duas páginas
+void ssd1306_frame_draw_char(uint8_t *ssd, int frame_width, int frame_height, int16_t x, int16_t y,
+                             uint8_t character) {
+    if (x <= -SSD1306_FONT_WIDTH || x >= frame_width || y <= -8 || y >= frame_height) {
+        return;
+    }
+
+    const uint8_t *glyph = &font[ssd1306_get_font(character) * SSD1306_FONT_WIDTH];
+    int page = y >> 3;                  // Página da parte de cima (arredonda para baixo quando y < 0)
+    uint shift = y & 7;
+    uint16_t mask = 0xFF << shift;
+    bool top_visible = page >= 0;
+    bool bottom_visible = shift != 0 && page + 1 < frame_height / 8;
+
+    // Colunas visíveis do caractere
+    int first = x < 0 ? -x : 0;
+    int last = x + SSD1306_FONT_WIDTH > frame_width ? frame_width - x : SSD1306_FONT_WIDTH;
+
+    int top = page * frame_width + x;
+    int bottom = top + frame_width;
+
+    for (int i = first; i < last; i++) {
+        uint16_t column = glyph[i] << shift;
+
+        if (top_visible) {
+            ssd[top + i] = (ssd[top + i] & ~mask) | column;
+        }
+        if (bottom_visible) {
+            ssd[bottom + i] = (ssd[bottom + i] & ~(mask >> 8)) | (column >> 8);
+        }
+    }
+}
+
+// Desenha uma string no quadro, chamando a função de desenhar caractere várias vezes (o que passa da borda
+// direita é cortado)
+void ssd1306_frame_draw_string(uint8_t *ssd, int frame_width, int frame_height, int16_t x, int16_t y,
+                               const char *string) {
+    while (*string && x < frame_width) {
+        ssd1306_frame_draw_char(ssd, frame_width, frame_height, x, y, *string++);
+        x += SSD1306_FONT_WIDTH;
+    }
+}
+
+// Os mesmos, no framebuffer de ssd1306_buffer_length bytes (por exemplo, ssd1306_back_buffer())
+void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character) {
+    ssd1306_frame_draw_char(ssd, ssd1306_width, ssd1306_height, x, y, character);
+}
+
+void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string) {
+    ssd1306_frame_draw_string(ssd, ssd1306_width, ssd1306_height, x, y, string);
+}
+
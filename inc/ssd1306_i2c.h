@@ -1,68 +1,126 @@
-#include <stdlib.h>
-#include "pico/stdlib.h"
-#include "hardware/i2c.h"
-
-#ifndef ssd1306_inc_h
-#define ssd1306_inc_h
-
-#define ssd1306_height 64 // Define a altura do display (32 pixels)
-#define ssd1306_width 128 // Define a largura do display (128 pixels)
-
-#define ssd1306_i2c_address _u(0x3C) // Define o endereço do i2c do display
-
-#define ssd1306_i2c_clock 400 // Define o tempo do clock (pode ser aumentado)
-
-// Comandos de configuração (endereços)
-#define ssd1306_set_memory_mode _u(0x20)
-#define ssd1306_set_column_address _u(0x21)
-#define ssd1306_set_page_address _u(0x22)
-#define ssd1306_set_horizontal_scroll _u(0x26)
-#define ssd1306_set_scroll _u(0x2E)
-
-#define ssd1306_set_display_start_line _u(0x40)
-
-#define ssd1306_set_contrast _u(0x81)
-#define ssd1306_set_charge_pump _u(0x8D)
-
-#define ssd1306_set_segment_remap _u(0xA0)
-#define ssd1306_set_entire_on _u(0xA4)
-#define ssd1306_set_all_on _u(0xA5)
-#define ssd1306_set_normal_display _u(0xA6)
-#define ssd1306_set_inverse_display _u(0xA7)
-#define ssd1306_set_mux_ratio _u(0xA8)
-#define ssd1306_set_display _u(0xAE)
-#define ssd1306_set_common_output_direction _u(0xC0)
-#define ssd1306_set_common_output_direction_flip _u(0xC0)
-
-#define ssd1306_set_display_offset _u(0xD3)
-#define ssd1306_set_display_clock_divide_ratio _u(0xD5)
-#define ssd1306_set_precharge _u(0xD9)
-#define ssd1306_set_common_pin_configuration _u(0xDA)
-#define ssd1306_set_vcomh_deselect_level _u(0xDB)
-
-#define ssd1306_page_height _u(8)
-#define ssd1306_n_pages (ssd1306_height / ssd1306_page_height)
-#define ssd1306_buffer_length (ssd1306_n_pages * ssd1306_width)
-
-#define ssd1306_write_mode _u(0xFE)
-#define ssd1306_read_mode _u(0xFF)
-
-struct render_area {
-    uint8_t start_column;
-    uint8_t end_column;
-    uint8_t start_page;
-    uint8_t end_page;
-
-    int buffer_length;
-};
-
-typedef struct {
-  uint8_t width, height, pages, address;
-  i2c_inst_t * i2c_port;
-  bool external_vcc;
-  uint8_t *ram_buffer;
-  size_t bufsize;
-  uint8_t port_buffer[2];
-} ssd1306_t;
-
+#include <stdlib.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#ifndef ssd1306_inc_h
+#define ssd1306_inc_h
+
+#define ssd1306_height 64 // Define a altura do display (32 pixels)
+#define ssd1306_width 128 // Define a largura do display (128 pixels)
+
+#define ssd1306_i2c_address _u(0x3C) // Define o endereço do i2c do display
+
+// Clock do barramento em kHz (pode ser aumentado; cmake -DREFLEX_I2C_KHZ=<kHz>, ver ssd1306_probe.h)
+#ifndef ssd1306_i2c_clock
+#define ssd1306_i2c_clock 400
+#endif
+
+// Comandos de configuração (endereços)
+#define ssd1306_set_memory_mode _u(0x20)
+#define ssd1306_set_column_address _u(0x21)
+#define ssd1306_set_page_address _u(0x22)
+#define ssd1306_set_horizontal_scroll _u(0x26)
+#define ssd1306_set_scroll _u(0x2E)
+
+#define ssd1306_set_display_start_line _u(0x40)
+
+#define ssd1306_set_contrast _u(0x81)
+#define ssd1306_set_charge_pump _u(0x8D)
+
+#define ssd1306_set_segment_remap _u(0xA0)
+#define ssd1306_set_entire_on _u(0xA4)
+#define ssd1306_set_all_on _u(0xA5)
+#define ssd1306_set_normal_display _u(0xA6)
+#define ssd1306_set_inverse_display _u(0xA7)
+#define ssd1306_set_mux_ratio _u(0xA8)
+#define ssd1306_set_display _u(0xAE)
+#define ssd1306_set_common_output_direction _u(0xC0)
+#define ssd1306_set_common_output_direction_flip _u(0xC0)
+
+#define ssd1306_set_display_offset _u(0xD3)
+#define ssd1306_set_display_clock_divide_ratio _u(0xD5)
+#define ssd1306_set_precharge _u(0xD9)
+#define ssd1306_set_common_pin_configuration _u(0xDA)
+#define ssd1306_set_vcomh_deselect_level _u(0xDB)
+
+#define ssd1306_page_height _u(8)
+#define ssd1306_n_pages (ssd1306_height / ssd1306_page_height)
+#define ssd1306_buffer_length (ssd1306_n_pages * ssd1306_width)
+
+// Maior lista de comandos enviada em uma única transação (listas maiores são divididas)
+#define SSD1306_MAX_COMMAND_LIST 32
+
+// Tamanho do buffer de um ssd1306_t (byte de controle 0x40 seguido das páginas), para ssd1306_init_bm_buffer
+#define SSD1306_BM_BUFFER_SIZE(width, height) ((width) * ((height) / 8U) + 1)
+
+#define ssd1306_write_mode _u(0xFE)
+#define ssd1306_read_mode _u(0xFF)
+
+struct render_area {
+    uint8_t start_column;
+    uint8_t end_column;
+    uint8_t start_page;
+    uint8_t end_page;
+
+    int buffer_length;
+};
+
+// Contadores de transações e bytes enviados pelo driver (contando o byte de controle, sem o byte de endereço I2C)
+typedef struct {
+  uint32_t transactions;
+  uint32_t bytes;
+} ssd1306_bus_stats_t;
+
+// Ritmo dos quadros publicados com ssd1306_flip (intervalos entre flips e duração dos envios por DMA, em µs)
+typedef struct {
+  uint32_t frames;            // Quadros enviados
+  uint32_t unchanged;         // Flips sem nenhuma mudança (nada enviado)
+  uint32_t last_interval_us;
+  uint32_t min_interval_us;
+  uint32_t max_interval_us;
+  uint32_t last_transfer_us;
+  uint32_t max_transfer_us;
+} ssd1306_frame_stats_t;
+
+// Estado de um display: geometria, barramento, buffers e envio em andamento. Todas as funções com
+// parâmetro ssd1306_t atuam só sobre a própria instância
+typedef struct {
+  uint8_t width, height, pages, address;
+  i2c_inst_t * i2c_port;
+  bool external_vcc;
+  uint8_t *ram_buffer;        // Byte de controle 0x40 seguido do quadro em desenho (buffer de trás)
+  size_t bufsize;
+  uint8_t port_buffer[2];
+
+  // Double buffer e envio por DMA (só nas instâncias criadas com SSD1306_INIT_DISPLAY)
+  uint8_t *front;             // Cópia do que o display exibe; NULL sem double buffer
+  bool front_valid;           // Falso até o primeiro quadro completo
+  uint16_t *tx_words;         // Palavras IC_DATA_CMD lidas pelo DMA; a primeira é o byte de controle 0x40
+  SemaphoreHandle_t tx_idle;  // Dado pela interrupção no fim de cada envio; qualquer tarefa pode esperar por ele
+  volatile bool tx_busy;
+  volatile bool tx_ok;
+  uint64_t tx_start_us;
+  uint64_t last_flip_us;
+
+  ssd1306_bus_stats_t bus_stats;
+  ssd1306_frame_stats_t frame_stats;
+} ssd1306_t;
+
+// Quadro do double buffer: 3 bytes de alinhamento e o byte de controle antes dos pixels
+#define SSD1306_FRAME_STRIDE(width, height) ((width) * ((height) / 8U) + 4)
+
+// Memória estática de uma instância com double buffer (dois quadros, as palavras do DMA e o semáforo de
+// fim de envio, que só é usado no perfil estático), em .bss
+#define SSD1306_STORAGE(name, width, height) \
+  static uint8_t name##_frames[2 * SSD1306_FRAME_STRIDE(width, height)] __attribute__((aligned(4))); \
+  static uint16_t name##_tx_words[SSD1306_BM_BUFFER_SIZE(width, height)]; \
+  static StaticSemaphore_t name##_tx_idle
+
+// Inicializa a instância ssd com a memória declarada por SSD1306_STORAGE(name, ...)
+#define SSD1306_INIT_DISPLAY(ssd, name, width, height, external_vcc, address, i2c) \
+  ssd1306_init_display(ssd, width, height, external_vcc, address, i2c, name##_frames, name##_tx_words, &name##_tx_idle)
+
 #endif
\ No newline at end of file
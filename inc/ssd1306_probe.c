@@ -0,0 +1,96 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "ssd1306_i2c.h"
+#include "ssd1306.h"
+#include "ssd1306_probe.h"
+
+// Bit D do byte de status: 1 com o display desligado
+#define SSD1306_STATUS_DISPLAY_OFF  0x40
+
+// Lê o byte de status; falso se o display não respondeu à leitura
+static bool ssd1306_probe_read_status(ssd1306_t *ssd, uint8_t *status) {
+    ssd1306_display_wait(ssd, portMAX_DELAY);
+    return i2c_read_timeout_us(ssd->i2c_port, ssd->address, status, 1, false, 2000) == 1;
+}
+
+// Envia SSD1306_PROBE_FRAMES quadros completos no clock atual; falso no primeiro envio sem ACK ou fora do prazo
+static bool ssd1306_probe_frames(ssd1306_t *ssd, ssd1306_probe_step_t *step) {
+    int length = ssd->bufsize - 1;
+    ssd1306_bus_stats_t before, after;
+
+    ssd1306_display_get_bus_stats(ssd, &before);
+    uint64_t start_us = time_us_64();
+
+    for (int frame = 0; frame < SSD1306_PROBE_FRAMES; frame++) {
+        // Xadrez e seu inverso: todos os bytes diferem do quadro anterior, então cada flip envia a tela toda
+        memset(ssd1306_display_back_buffer(ssd), (frame & 1) ? 0xAA : 0x55, length);
+        ssd1306_display_flip(ssd);
+
+        if (!ssd1306_display_wait(ssd, pdMS_TO_TICKS(SSD1306_PROBE_TIMEOUT_MS))) {
+            return false;
+        }
+    }
+
+    uint64_t elapsed_us = time_us_64() - start_us;
+    ssd1306_display_get_bus_stats(ssd, &after);
+
+    if (elapsed_us == 0) {
+        elapsed_us = 1;
+    }
+    step->frames_per_s = (uint32_t)(SSD1306_PROBE_FRAMES * 1000000ull / elapsed_us);
+    step->bytes_per_s = (uint32_t)((uint64_t)(after.bytes - before.bytes) * 1000000ull / elapsed_us);
+    return true;
+}
+
+int ssd1306_probe_bus_speed(ssd1306_t *ssd, const uint32_t *rates, int count, ssd1306_probe_step_t *steps, uint32_t *chosen_hz) {
+    uint32_t best_hz = rates[0];        // Se nem o primeiro passar, o barramento fica no menor clock da lista
+    uint8_t status;
+    int tested = 0;
+
+    // A leitura de status só entra na verificação se funcionar no clock inicial (nem todo módulo a permite)
+    bool check_status = ssd1306_probe_read_status(ssd, &status) && !(status & SSD1306_STATUS_DISPLAY_OFF);
+
+    for (int i = 0; i < count; i++) {
+        ssd1306_probe_step_t *step = &steps[tested++];
+
+        memset(step, 0, sizeof(*step));
+        step->requested_hz = rates[i];
+
+        ssd1306_display_wait(ssd, portMAX_DELAY);
+        step->actual_hz = i2c_set_baudrate(ssd->i2c_port, rates[i]);
+
+        step->ok = ssd1306_probe_frames(ssd, step);
+        if (step->ok && check_status) {
+            step->ok = ssd1306_probe_read_status(ssd, &status) && !(status & SSD1306_STATUS_DISPLAY_OFF);
+        }
+
+        if (!step->ok) {
+            break; // Clocks maiores não serão mais estáveis que este
+        }
+        best_hz = rates[i];
+    }
+
+    // Volta ao último clock aprovado; um envio recusado pode ter deixado o display num estado qualquer
+    ssd1306_display_wait(ssd, portMAX_DELAY);
+    i2c_set_baudrate(ssd->i2c_port, best_hz);
+    ssd1306_config(ssd);
+
+    memset(ssd1306_display_back_buffer(ssd), 0, ssd->bufsize - 1);
+    ssd1306_display_flip(ssd);
+    ssd1306_display_wait(ssd, portMAX_DELAY);
+
+    *chosen_hz = best_hz;
+    return tested;
+}
+
+void ssd1306_probe_print(const ssd1306_probe_step_t *steps, int count, uint32_t chosen_hz) {
+    for (int i = 0; i < count; i++) {
+        printf("i2c,%lu,%lu,%d,%lu,%lu\n", (unsigned long)steps[i].requested_hz, (unsigned long)steps[i].actual_hz,
+               steps[i].ok ? 1 : 0, (unsigned long)steps[i].frames_per_s, (unsigned long)steps[i].bytes_per_s);
+    }
+    printf("i2c_escolhido,%lu\n", (unsigned long)chosen_hz);
+}
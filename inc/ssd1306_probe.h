@@ -0,0 +1,36 @@
+#include "pico/stdlib.h"
+#include "ssd1306_i2c.h"
+
+#ifndef ssd1306_probe_inc_h
+#define ssd1306_probe_inc_h
+
+// Sonda de velocidade do barramento: sobe o clock do I2C passo a passo e, em cada passo, envia quadros
+// completos (padrões alternados, para que todo byte mude) conferindo o ACK de cada transferência e, se o
+// módulo permitir leitura, o byte de status do display. Fica com o clock mais rápido em que tudo passou.
+// O SSD1306 não permite ler a RAM de vídeo pelo I2C, então o quadro não é comparado com uma referência
+
+#define SSD1306_PROBE_FRAMES        16      // Quadros enviados em cada passo
+#define SSD1306_PROBE_TIMEOUT_MS    200     // Tempo máximo de um quadro antes de o passo ser reprovado
+#define SSD1306_PROBE_MAX_STEPS     8
+
+// Clocks testados por padrão, em Hz (do I2C rápido ao rápido plus e além)
+#define SSD1306_PROBE_DEFAULT_RATES { 400000, 600000, 800000, 1000000, 1200000, 1500000 }
+
+// Resultado de um passo
+typedef struct {
+  uint32_t requested_hz;
+  uint32_t actual_hz;                 // Clock efetivo obtido pelo divisor do I2C
+  bool ok;
+  uint32_t frames_per_s;
+  uint32_t bytes_per_s;               // Bytes no barramento (comandos e pixels, sem o byte de endereço)
+} ssd1306_probe_step_t;
+
+// Testa os clocks de rates (em ordem crescente) até o primeiro que falhar e deixa o barramento no último
+// aprovado (ou no primeiro da lista, se nenhum passar). O display é reconfigurado e limpo no fim. steps recebe um resultado por passo testado
+// (até count); retorna quantos passos foram testados, e *chosen_hz recebe o clock escolhido
+int ssd1306_probe_bus_speed(ssd1306_t *ssd, const uint32_t *rates, int count, ssd1306_probe_step_t *steps, uint32_t *chosen_hz);
+
+// Imprime os passos como CSV: i2c,<hz pedido>,<hz efetivo>,<ok>,<quadros/s>,<bytes/s>
+void ssd1306_probe_print(const ssd1306_probe_step_t *steps, int count, uint32_t chosen_hz);
+
+#endif
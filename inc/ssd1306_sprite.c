@@ -0,0 +1,135 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "ssd1306_i2c.h"
+#include "ssd1306.h"
+#include "ssd1306_sprite.h"
+
+// Combina value com o byte do quadro, só nos bits de mask
+static inline void ssd1306_sprite_apply(uint8_t *byte, uint8_t value, uint8_t mask, ssd1306_blit_mode_t mode) {
+    switch (mode) {
+        case SSD1306_BLIT_OPAQUE:
+            *byte = (*byte & ~mask) | (value & mask);
+            break;
+        case SSD1306_BLIT_OR:
+            *byte |= value & mask;
+            break;
+        default:
+            *byte ^= value & mask;
+            break;
+    }
+}
+
+bool ssd1306_sprite_blit(uint8_t *frame, int frame_width, int frame_height, const ssd1306_sprite_t *sprite,
+                         int x, int y, ssd1306_blit_mode_t mode, struct render_area *area) {
+    int frame_pages = frame_height / 8;
+
+    // Recorte nas bordas (em pixels)
+    int first_column = x < 0 ? -x : 0;
+    int last_column = x + sprite->width > frame_width ? frame_width - 1 - x : sprite->width - 1;
+    int top = y < 0 ? 0 : y;
+    int bottom = y + sprite->height > frame_height ? frame_height - 1 : y + sprite->height - 1;
+
+    if (first_column > last_column || top > bottom) {
+        return false;
+    }
+
+    // Cada página da imagem cai sobre duas páginas do quadro, deslocada de shift bits
+    int shift = y & 7;
+    int base_page = (y - shift) / 8;
+    int sprite_pages = (sprite->height + 7) / 8;
+    uint8_t last_mask = (sprite->height & 7) ? (uint8_t)((1u << (sprite->height & 7)) - 1) : 0xFF;
+
+    for (int page = 0; page < sprite_pages; page++) {
+        const uint8_t *source = &sprite->data[page * sprite->width];
+        uint16_t mask = (uint16_t)((page == sprite_pages - 1 ? last_mask : 0xFF) << shift);
+        int upper = base_page + page;
+        int lower = upper + 1;
+        bool upper_visible = upper >= 0 && upper < frame_pages;
+        bool lower_visible = shift != 0 && lower >= 0 && lower < frame_pages;
+
+        if (!upper_visible && !lower_visible) {
+            continue;
+        }
+
+        int upper_offset = upper * frame_width + x;
+        int lower_offset = lower * frame_width + x;
+
+        for (int i = first_column; i <= last_column; i++) {
+            uint16_t value = (uint16_t)(source[i] << shift);
+
+            if (upper_visible) {
+                ssd1306_sprite_apply(&frame[upper_offset + i], (uint8_t)value, (uint8_t)mask, mode);
+            }
+            if (lower_visible) {
+                ssd1306_sprite_apply(&frame[lower_offset + i], (uint8_t)(value >> 8), (uint8_t)(mask >> 8), mode);
+            }
+        }
+    }
+
+    if (area != NULL) {
+        area->start_column = x + first_column;
+        area->end_column = x + last_column;
+        area->start_page = top / 8;
+        area->end_page = bottom / 8;
+        calculate_render_area_buffer_length(area);
+    }
+
+    return true;
+}
+
+bool ssd1306_sprite_unpack(const ssd1306_packed_sprite_t *packed, uint8_t *buffer, size_t buffer_size,
+                           ssd1306_sprite_t *sprite) {
+    size_t length = (size_t)((packed->height + 7) / 8) * packed->width;
+    size_t out = 0;
+    uint i = 0;
+
+    if (buffer_size < length) {
+        return false;
+    }
+
+    while (i < packed->size && out < length) {
+        uint control = packed->data[i++];
+
+        if (control < 128) {
+            uint count = control + 1;   // Bytes literais
+
+            if (i + count > packed->size || out + count > length) {
+                return false;
+            }
+            memcpy(&buffer[out], &packed->data[i], count);
+            i += count;
+            out += count;
+        }
+        else {
+            uint count = control - 126; // Repetições do próximo byte
+
+            if (i >= packed->size || out + count > length) {
+                return false;
+            }
+            memset(&buffer[out], packed->data[i++], count);
+            out += count;
+        }
+    }
+
+    sprite->width = packed->width;
+    sprite->height = packed->height;
+    sprite->data = buffer;
+    return out == length;
+}
+
+bool ssd1306_blit(uint8_t *ssd, const ssd1306_sprite_t *sprite, int x, int y, ssd1306_blit_mode_t mode,
+                  struct render_area *area) {
+    return ssd1306_sprite_blit(ssd, ssd1306_width, ssd1306_height, sprite, x, y, mode, area);
+}
+
+bool ssd1306_draw_sprite(ssd1306_t *ssd, const ssd1306_sprite_t *sprite, int x, int y, ssd1306_blit_mode_t mode) {
+    struct render_area area;
+
+    // O primeiro byte de ram_buffer é o byte de controle 0x40; as páginas vêm em seguida
+    if (!ssd1306_sprite_blit(&ssd->ram_buffer[1], ssd->width, ssd->height, sprite, x, y, mode, &area)) {
+        return false;
+    }
+
+    ssd1306_send_area(ssd, &area);
+    return true;
+}
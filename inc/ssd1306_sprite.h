@@ -0,0 +1,52 @@
+#include "pico/stdlib.h"
+#include "ssd1306_i2c.h"
+
+#ifndef ssd1306_sprite_inc_h
+#define ssd1306_sprite_inc_h
+
+// Imagens 1bpp de qualquer tamanho no mesmo formato do framebuffer: páginas de 8 linhas (bit 0 em cima),
+// cada página com width bytes, da esquerda para a direita; a última página pode estar incompleta.
+// Declaradas como const, os dados ficam na flash e são lidos dali pelo blit, sem cópia para a RAM
+typedef struct {
+    uint8_t width;
+    uint8_t height;
+    const uint8_t *data;                // ((height + 7) / 8) * width bytes
+} ssd1306_sprite_t;
+
+// Imagem comprimida (tools/asset_compiler.py, opção ":rle"): os bytes de ssd1306_sprite_t em sequências que
+// começam por um byte de controle n. Se n < 128, seguem n + 1 bytes copiados como estão; senão, o byte
+// seguinte se repete n - 126 vezes. Compensa em imagens grandes com muito fundo liso
+typedef struct {
+    uint8_t width;
+    uint8_t height;
+    uint16_t size;                      // Bytes comprimidos em data
+    const uint8_t *data;
+} ssd1306_packed_sprite_t;
+
+// Como os pixels da imagem se combinam com os do quadro
+typedef enum {
+    SSD1306_BLIT_OPAQUE = 0,            // Substitui o retângulo inteiro (bits 0 apagam)
+    SSD1306_BLIT_OR = 1,                // Transparente: só os bits 1 acendem pixels
+    SSD1306_BLIT_XOR = 2                // Inverte os pixels sob os bits 1
+} ssd1306_blit_mode_t;
+
+// Desenha a imagem com o canto superior esquerdo em (x, y) num quadro de frame_width x frame_height pixels,
+// recortando nas bordas. Se area não for nula, recebe a janela de colunas/páginas alterada.
+// Retorna falso se nada ficou dentro do quadro
+bool ssd1306_sprite_blit(uint8_t *frame, int frame_width, int frame_height, const ssd1306_sprite_t *sprite,
+                         int x, int y, ssd1306_blit_mode_t mode, struct render_area *area);
+
+// O mesmo, no framebuffer de ssd1306_buffer_length bytes (por exemplo, ssd1306_back_buffer())
+bool ssd1306_blit(uint8_t *ssd, const ssd1306_sprite_t *sprite, int x, int y, ssd1306_blit_mode_t mode,
+                  struct render_area *area);
+
+// Descomprime a imagem em buffer e aponta sprite para o resultado, pronto para os blits. Uma imagem do tamanho
+// da tela pode ser descomprimida direto no framebuffer (por exemplo, ssd1306_back_buffer()).
+// Retorna falso se buffer_size for menor que a imagem ou se os dados não formarem a imagem inteira
+bool ssd1306_sprite_unpack(const ssd1306_packed_sprite_t *packed, uint8_t *buffer, size_t buffer_size,
+                           ssd1306_sprite_t *sprite);
+
+// Desenha no buffer de um ssd1306_t e envia ao display só a janela alterada, numa única vez
+bool ssd1306_draw_sprite(ssd1306_t *ssd, const ssd1306_sprite_t *sprite, int x, int y, ssd1306_blit_mode_t mode);
+
+#endif
@@ -42,12 +42,24 @@
 
 /* Scheduler Related */
 #define configUSE_PREEMPTION                    1
+#if defined( REFLEX_TICKLESS ) && REFLEX_TICKLESS && !defined( REFLEX_HOST_BUILD ) && !( defined( REFLEX_SMP ) && REFLEX_SMP )
+/* Tickless idle (cmake -DREFLEX_TICKLESS=ON): custom vPortSuppressTicksAndSleep in
+src/low_power.c, woken by a hardware alarm. Not available on SMP or on the host. */
+#define configUSE_TICKLESS_IDLE                 2
+#else
 #define configUSE_TICKLESS_IDLE                 0
+#endif
 #define configUSE_IDLE_HOOK                     0
 #define configUSE_TICK_HOOK                     0
 #define configTICK_RATE_HZ                      ( ( TickType_t ) 1000 )
 #define configMAX_PRIORITIES                    32
+#ifdef REFLEX_HOST_BUILD
+/* The POSIX port runs each task on a pthread, whose stack must be at least
+PTHREAD_STACK_MIN (16 KB). */
+#define configMINIMAL_STACK_SIZE                ( configSTACK_DEPTH_TYPE ) 2048
+#else
 #define configMINIMAL_STACK_SIZE                ( configSTACK_DEPTH_TYPE ) 256
+#endif
 #define configUSE_16_BIT_TICKS                  0
 
 #define configIDLE_SHOULD_YIELD                 1
@@ -70,18 +82,39 @@
 #define configMESSAGE_BUFFER_LENGTH_TYPE        size_t
 
 /* Memory allocation related definitions. */
+#if defined( REFLEX_STATIC_ALLOC ) && REFLEX_STATIC_ALLOC
+/* Zero-heap profile (cmake -DREFLEX_STATIC_ALLOC=ON): every task, queue and timer
+is created from static memory (see src/rtos_alloc.h) and no FreeRTOS heap is linked. */
+#define configSUPPORT_STATIC_ALLOCATION         1
+#define configSUPPORT_DYNAMIC_ALLOCATION        0
+#define configUSE_MALLOC_FAILED_HOOK            0
+#else
 #define configSUPPORT_STATIC_ALLOCATION         0
 #define configSUPPORT_DYNAMIC_ALLOCATION        1
+/* Allocation failures halt in vApplicationMallocFailedHook (src/mem_stats.c). */
+#define configUSE_MALLOC_FAILED_HOOK            1
+#endif
 #define configTOTAL_HEAP_SIZE                   (128*1024)
 #define configAPPLICATION_ALLOCATED_HEAP        0
 
 /* Hook function related definitions. */
-#define configCHECK_FOR_STACK_OVERFLOW          0
-#define configUSE_MALLOC_FAILED_HOOK            0
+/* Method 2 checks the stack end pattern on every context switch and halts in
+vApplicationStackOverflowHook (src/mem_stats.c), so stacks sized from the
+mem_stats report fail loudly instead of corrupting memory. */
+#define configCHECK_FOR_STACK_OVERFLOW          2
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
 /* Run time and task stats gathering related definitions. */
+#if defined( REFLEX_TRACE ) && REFLEX_TRACE
+/* Trace build (cmake -DREFLEX_TRACE=ON): per-task CPU time on the 1 MHz timer,
+streamed by the task in src/trace.c. */
+#define configGENERATE_RUN_TIME_STATS           1
+#define configRUN_TIME_COUNTER_TYPE             uint64_t
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()        trace_run_time_us()
+#else
 #define configGENERATE_RUN_TIME_STATS           0
+#endif
 #define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
@@ -93,7 +126,11 @@
 #define configUSE_TIMERS                        1
 #define configTIMER_TASK_PRIORITY               ( configMAX_PRIORITIES - 1 )
 #define configTIMER_QUEUE_LENGTH                10
+#ifdef REFLEX_HOST_BUILD
+#define configTIMER_TASK_STACK_DEPTH            configMINIMAL_STACK_SIZE
+#else
 #define configTIMER_TASK_STACK_DEPTH            1024
+#endif
 
 /* Interrupt nesting behaviour configuration. */
 /*
@@ -102,13 +139,17 @@
 #define configMAX_API_CALL_INTERRUPT_PRIORITY   [dependent on processor and application]
 */
 
-// #if FREE_RTOS_KERNEL_SMP // set by the RP2040 SMP port of FreeRTOS
-// /* SMP port only */
-// #define configNUMBER_OF_CORES                   2
-// #define configTICK_CORE                         0
-// #define configRUN_MULTIPLE_PRIORITIES           1
-// #define configUSE_CORE_AFFINITY                 1
-// #endif
+#if defined( REFLEX_SMP ) && REFLEX_SMP
+/* SMP build (cmake -DREFLEX_SMP=ON): the display task is pinned to core 1 and
+the game task to core 0, see main.c. */
+#define configNUMBER_OF_CORES                   2
+#define configTICK_CORE                         0
+#define configRUN_MULTIPLE_PRIORITIES           1
+#define configUSE_CORE_AFFINITY                 1
+#define configUSE_PASSIVE_IDLE_HOOK             0
+#else
+#define configNUMBER_OF_CORES                   1
+#endif
 
 /* RP2040 specific */
 #define configSUPPORT_PICO_SYNC_INTEROP         1
@@ -138,5 +179,11 @@ to exclude the API function. */
 #define INCLUDE_xQueueGetMutexHolder            1
 
 /* A header file that defines trace macro can be included here. */
+#if defined( REFLEX_TRACE ) && REFLEX_TRACE && !defined( __ASSEMBLER__ )
+/* Implemented in src/trace.c. */
+extern uint64_t trace_run_time_us( void );
+extern void trace_task_switched_in( void );
+#define traceTASK_SWITCHED_IN()                 trace_task_switched_in()
+#endif
 
 #endif /* FREERTOS_CONFIG_H */
\ No newline at end of file
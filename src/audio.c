@@ -0,0 +1,402 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "timers.h"
+#include "audio.h"
+#include "audio_dma.h"
+#include "audio_tables.h"
+#include "rtos_alloc.h"
+
+// Sintetizador dos buzzers: cada voz toca uma forma de onda da flash (audio_tables.h, gerado na compilação)
+// com um acumulador de fase e uma envoltória ADSR. As amostras são calculadas na tarefa do áudio, um bloco
+// por vez, quando a interrupção do DMA avisa que um bloco terminou (audio_dma.c); as filas e os timers só dizem
+// à tarefa o que tocar, então uma nota custa à CPU apenas o preenchimento dos blocos, sem nenhum trabalho por
+// período da onda e sem cálculo de amostras dentro de interrupções
+
+// Operações executadas no contexto do timer de software (audio_service)
+#define AUDIO_NEXT          0         // Começa a próxima nota se o buzzer estiver livre
+#define AUDIO_SILENCE       1         // Interrompe a nota atual
+
+// A envoltória e o volume são atualizados a cada AUDIO_CONTROL_SAMPLES amostras (0,5 ms a 32 kHz)
+#define AUDIO_CONTROL_SAMPLES   16
+#define AUDIO_CONTROL_PER_SEC   (AUDIO_SAMPLE_RATE / AUDIO_CONTROL_SAMPLES)
+#define AUDIO_LEVEL_SHIFT       16
+#define AUDIO_LEVEL_MAX         (255u << AUDIO_LEVEL_SHIFT)  // Envoltória em Q16: 8 bits inteiros de ganho
+
+// Comando publicado pelo timer de software para a tarefa do áudio
+enum {
+    AUDIO_COMMAND_OFF,          // Silêncio imediato
+    AUDIO_COMMAND_ON,           // Nota nova: subida a partir do nível atual (sem estalo entre notas ligadas)
+    AUDIO_COMMAND_RELEASE       // Fim da nota: extinção
+};
+
+// Etapas da envoltória, só usadas na tarefa do áudio
+enum {
+    AUDIO_STAGE_IDLE,
+    AUDIO_STAGE_ATTACK,
+    AUDIO_STAGE_DECAY,
+    AUDIO_STAGE_SUSTAIN,
+    AUDIO_STAGE_RELEASE
+};
+
+typedef struct {
+    uint8_t command;
+    uint8_t wave;
+    uint8_t gain;
+    uint32_t phase_step;
+    uint32_t sustain_level;
+    uint32_t attack_step;       // Variação da envoltória por bloco de controle
+    uint32_t decay_step;
+    uint32_t release_step;
+} audio_command_t;
+
+// Cada voz é um buzzer com sua fila de notas e um timer de disparo único que marca o fim da nota.
+// O estado de "tocando" só é lido e escrito no contexto do timer, então não precisa de seção crítica.
+// O comando é um seqlock (como em game_state.c): o timer escreve com a sequência ímpar dentro de uma seção
+// crítica e a tarefa do áudio só o aplica se ler a mesma sequência par antes e depois da cópia; se não, tenta de
+// novo no bloco seguinte, sem nunca esperar
+typedef struct {
+    uint gpio;
+    uint output;
+    QueueHandle_t notes;
+    TimerHandle_t timer;
+    bool playing;
+    const audio_instrument_t *instrument;
+
+    audio_command_t command;
+    uint32_t sequence;
+
+    // Estado da tarefa do áudio
+    audio_command_t active;
+    uint32_t applied_sequence;
+    uint32_t phase;
+    uint32_t level;
+    uint8_t stage;
+} audio_voice_t;
+
+const audio_instrument_t audio_instrument_beep = {
+    .wave = AUDIO_WAVE_SQUARE, .volume = 13, .sustain = 200, .attack_ms = 2, .decay_ms = 40, .release_ms = 20
+};
+const audio_instrument_t audio_instrument_bell = {
+    .wave = AUDIO_WAVE_SINE, .volume = 15, .sustain = 90, .attack_ms = 1, .decay_ms = 250, .release_ms = 300
+};
+const audio_instrument_t audio_instrument_soft = {
+    .wave = AUDIO_WAVE_ORGAN, .volume = 11, .sustain = 220, .attack_ms = 30, .decay_ms = 60, .release_ms = 120
+};
+
+RTOS_QUEUE_STORAGE(audio_notes_0, AUDIO_QUEUE_LENGTH, sizeof(audio_note_t));
+RTOS_QUEUE_STORAGE(audio_notes_1, AUDIO_QUEUE_LENGTH, sizeof(audio_note_t));
+RTOS_TIMER_STORAGE(audio_timer_0);
+RTOS_TIMER_STORAGE(audio_timer_1);
+
+static audio_voice_t audio_voices[AUDIO_MAX_VOICES];
+static uint audio_voice_count = 0;
+
+static audio_voice_t *audio_find_voice(uint gpio) {
+    for (uint i = 0; i < audio_voice_count; i++) {
+        if (audio_voices[i].gpio == gpio) {
+            return &audio_voices[i];
+        }
+    }
+    return NULL;
+}
+
+// Variação por bloco de controle para percorrer distance em duration_ms (as divisões ficam aqui, fora do áudio)
+static uint32_t audio_envelope_step(uint32_t distance, uint32_t duration_ms) {
+    uint32_t blocks = duration_ms * AUDIO_CONTROL_PER_SEC / 1000;
+    return blocks > 0 ? distance / blocks : distance;
+}
+
+// Publica o comando da voz para a tarefa do áudio
+static void audio_command(audio_voice_t *voice, uint8_t command, uint32_t phase_step, const audio_instrument_t *instrument) {
+    uint32_t sustain_level = (uint32_t)instrument->sustain << AUDIO_LEVEL_SHIFT;
+    uint8_t volume = instrument->volume < AUDIO_VOLUME_STEPS ? instrument->volume : AUDIO_VOLUME_STEPS - 1;
+
+    taskENTER_CRITICAL();
+    __atomic_store_n(&voice->sequence, voice->sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);    // Sequência ímpar visível antes dos campos novos
+
+    __atomic_store_n(&voice->command.command, command, __ATOMIC_RELAXED);
+    __atomic_store_n(&voice->command.wave, instrument->wave, __ATOMIC_RELAXED);
+    __atomic_store_n(&voice->command.gain, audio_volume_table[volume], __ATOMIC_RELAXED);
+    __atomic_store_n(&voice->command.phase_step, phase_step, __ATOMIC_RELAXED);
+    __atomic_store_n(&voice->command.sustain_level, sustain_level, __ATOMIC_RELAXED);
+    __atomic_store_n(&voice->command.attack_step, audio_envelope_step(AUDIO_LEVEL_MAX, instrument->attack_ms), __ATOMIC_RELAXED);
+    __atomic_store_n(&voice->command.decay_step, audio_envelope_step(AUDIO_LEVEL_MAX - sustain_level, instrument->decay_ms), __ATOMIC_RELAXED);
+    __atomic_store_n(&voice->command.release_step, audio_envelope_step(AUDIO_LEVEL_MAX, instrument->release_ms), __ATOMIC_RELAXED);
+
+    __atomic_store_n(&voice->sequence, voice->sequence + 1, __ATOMIC_RELEASE);
+    taskEXIT_CRITICAL();
+}
+
+// Aplica o comando mais recente, se houver um novo e ele não estiver sendo escrito. Executada na tarefa do áudio
+static void audio_apply_command(audio_voice_t *voice) {
+    uint32_t before = __atomic_load_n(&voice->sequence, __ATOMIC_ACQUIRE);
+    audio_command_t command;
+
+    if ((before & 1) != 0 || before == voice->applied_sequence) {
+        return;
+    }
+
+    command.command = __atomic_load_n(&voice->command.command, __ATOMIC_RELAXED);
+    command.wave = __atomic_load_n(&voice->command.wave, __ATOMIC_RELAXED);
+    command.gain = __atomic_load_n(&voice->command.gain, __ATOMIC_RELAXED);
+    command.phase_step = __atomic_load_n(&voice->command.phase_step, __ATOMIC_RELAXED);
+    command.sustain_level = __atomic_load_n(&voice->command.sustain_level, __ATOMIC_RELAXED);
+    command.attack_step = __atomic_load_n(&voice->command.attack_step, __ATOMIC_RELAXED);
+    command.decay_step = __atomic_load_n(&voice->command.decay_step, __ATOMIC_RELAXED);
+    command.release_step = __atomic_load_n(&voice->command.release_step, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);      // Campos lidos antes de conferir a sequência de novo
+
+    if (__atomic_load_n(&voice->sequence, __ATOMIC_RELAXED) != before) {
+        return;
+    }
+    voice->applied_sequence = before;
+
+    if (command.command == AUDIO_COMMAND_OFF) {
+        voice->stage = AUDIO_STAGE_IDLE;
+        voice->level = 0;
+    }
+    else if (command.command == AUDIO_COMMAND_ON) {
+        voice->active = command;
+        voice->stage = AUDIO_STAGE_ATTACK;
+    }
+    else if (voice->stage != AUDIO_STAGE_IDLE) {
+        voice->active.release_step = command.release_step;
+        voice->stage = AUDIO_STAGE_RELEASE;
+    }
+}
+
+// Avança a envoltória um bloco de controle
+static void audio_envelope(audio_voice_t *voice) {
+    const audio_command_t *active = &voice->active;
+
+    switch (voice->stage) {
+    case AUDIO_STAGE_ATTACK:
+        if (AUDIO_LEVEL_MAX - voice->level <= active->attack_step) {
+            voice->level = AUDIO_LEVEL_MAX;
+            voice->stage = AUDIO_STAGE_DECAY;
+        }
+        else {
+            voice->level += active->attack_step;
+        }
+        break;
+    case AUDIO_STAGE_DECAY:
+        if (voice->level <= active->sustain_level + active->decay_step) {
+            voice->level = active->sustain_level;
+            voice->stage = AUDIO_STAGE_SUSTAIN;
+        }
+        else {
+            voice->level -= active->decay_step;
+        }
+        break;
+    case AUDIO_STAGE_RELEASE:
+        if (voice->level <= active->release_step) {
+            voice->level = 0;
+            voice->stage = AUDIO_STAGE_IDLE;
+        }
+        else {
+            voice->level -= active->release_step;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+// Soma a voz em mix. Só multiplicações e deslocamentos: o Cortex-M0+ não tem ponto flutuante nem divisão
+static void audio_render_voice(audio_voice_t *voice, int16_t *mix, uint count) {
+    const int8_t *wave = audio_waves[voice->active.wave];
+    uint32_t phase = voice->phase;
+    uint32_t step = voice->active.phase_step;
+
+    for (uint i = 0; i < count && voice->stage != AUDIO_STAGE_IDLE; i += AUDIO_CONTROL_SAMPLES) {
+        int32_t amplitude = (int32_t)(voice->active.gain * (voice->level >> AUDIO_LEVEL_SHIFT)) >> 8;
+        uint end = i + AUDIO_CONTROL_SAMPLES < count ? i + AUDIO_CONTROL_SAMPLES : count;
+
+        for (uint j = i; j < end; j++) {
+            mix[j] += (int16_t)((wave[phase >> 24] * amplitude) >> 8);
+            phase += step;
+        }
+        audio_envelope(voice);
+    }
+    voice->phase = phase;
+}
+
+// Preenche um bloco da saída com a soma das vozes ligadas a ela (audio_dma_fill_t, na tarefa do áudio).
+// O silêncio fica no nível central, o mesmo em torno do qual o som oscila, então o começo e o fim das notas
+// não deslocam a média do PWM (o que estalaria no buzzer)
+static bool audio_render(uint output, uint16_t *block, uint count) {
+    static int16_t mix[AUDIO_BLOCK_SAMPLES];    // Estático para não pesar na pilha; só a tarefa do áudio chama
+    bool sounding = false;
+
+    for (uint v = 0; v < audio_voice_count; v++) {
+        audio_voice_t *voice = &audio_voices[v];
+
+        if (voice->output != output) {
+            continue;
+        }
+        audio_apply_command(voice);
+        if (voice->stage != AUDIO_STAGE_IDLE) {
+            if (!sounding) {
+                memset(mix, 0, sizeof(mix));
+                sounding = true;
+            }
+            audio_render_voice(voice, mix, count);
+        }
+    }
+
+    // O bloco é sempre reescrito: o transporte pode ter deixado nele a rampa de uma parada
+    if (!sounding) {
+        for (uint i = 0; i < count; i++) {
+            block[i] = AUDIO_CENTER_LEVEL;
+        }
+        return false;
+    }
+
+    for (uint i = 0; i < count; i++) {
+        int32_t sample = mix[i] + AUDIO_CENTER_LEVEL;
+
+        block[i] = sample < 0 ? 0 : sample > AUDIO_PWM_WRAP ? AUDIO_PWM_WRAP : (uint16_t)sample;
+    }
+    return true;
+}
+
+// Toca a próxima nota da fila, se houver; sem notas, a atual entra em extinção. Executada apenas no contexto
+// do timer de software
+static void audio_next_note(audio_voice_t *voice) {
+    audio_note_t note;
+
+    if (xQueueReceive(voice->notes, &note, 0) != pdTRUE) {
+        if (voice->playing) {
+            audio_command(voice, AUDIO_COMMAND_RELEASE, 0, voice->instrument);
+        }
+        voice->playing = false;
+        return;
+    }
+
+    TickType_t ticks = pdMS_TO_TICKS(note.duration_ms);
+
+    voice->playing = true;
+    if (note.phase_step == 0) {
+        audio_command(voice, AUDIO_COMMAND_RELEASE, 0, note.instrument);
+    }
+    else {
+        audio_command(voice, AUDIO_COMMAND_ON, note.phase_step, note.instrument);
+        audio_dma_start();      // Acorda o DMA se ele parou no silêncio
+    }
+    xTimerChangePeriod(voice->timer, ticks > 0 ? ticks : 1, 0); // Também (re)inicia o timer
+}
+
+// Fim da nota atual: passa para a próxima
+static void audio_timer_callback(TimerHandle_t timer) {
+    audio_next_note(pvTimerGetTimerID(timer));
+}
+
+// Pedidos das tarefas, repassados ao contexto do timer por xTimerPendFunctionCall
+static void audio_service(void *param, uint32_t operation) {
+    audio_voice_t *voice = param;
+
+    if (operation == AUDIO_SILENCE) {
+        xTimerStop(voice->timer, 0);
+        audio_command(voice, AUDIO_COMMAND_OFF, 0, voice->instrument);
+        voice->playing = false;
+    }
+    else if (!voice->playing) {
+        audio_next_note(voice);
+    }
+}
+
+void audio_init(const uint *pins, uint count, UBaseType_t core_mask) {
+    QueueHandle_t queues[AUDIO_MAX_VOICES] = {
+        RTOS_QUEUE_CREATE(audio_notes_0, AUDIO_QUEUE_LENGTH, sizeof(audio_note_t)),
+        RTOS_QUEUE_CREATE(audio_notes_1, AUDIO_QUEUE_LENGTH, sizeof(audio_note_t))
+    };
+    TimerHandle_t timers[AUDIO_MAX_VOICES] = {
+        RTOS_TIMER_CREATE(audio_timer_0, "Audio 0", 1, pdFALSE, &audio_voices[0], audio_timer_callback),
+        RTOS_TIMER_CREATE(audio_timer_1, "Audio 1", 1, pdFALSE, &audio_voices[1], audio_timer_callback)
+    };
+
+    configASSERT(count <= AUDIO_MAX_VOICES && count <= AUDIO_MAX_OUTPUTS);
+
+    // Um buzzer por voz: a voz i toca na saída i
+    for (uint i = 0; i < count; i++) {
+        audio_voice_t *voice = &audio_voices[i];
+
+        configASSERT(queues[i] != NULL && timers[i] != NULL);
+
+        voice->gpio = pins[i];
+        voice->output = i;
+        voice->notes = queues[i];
+        voice->timer = timers[i];
+        voice->playing = false;
+        voice->instrument = &audio_instrument_beep;
+        voice->stage = AUDIO_STAGE_IDLE;
+    }
+    audio_voice_count = count;
+
+    audio_dma_init(pins, count, AUDIO_SAMPLE_RATE, audio_render, core_mask);
+}
+
+void audio_set_instrument(uint gpio, const audio_instrument_t *instrument) {
+    audio_voice_t *voice = audio_find_voice(gpio);
+
+    if (voice != NULL) {
+        voice->instrument = instrument;     // Vale para as próximas chamadas de audio_play
+    }
+}
+
+static bool audio_enqueue(audio_voice_t *voice, const audio_note_t *note) {
+    if (voice == NULL || xQueueSend(voice->notes, note, 0) != pdTRUE) {
+        return false;
+    }
+    // O timer de software tem prioridade máxima: a nota começa antes de a tarefa seguir adiante
+    return xTimerPendFunctionCall(audio_service, voice, AUDIO_NEXT, 0) == pdPASS;
+}
+
+bool audio_play(uint gpio, uint32_t frequency, uint32_t duration_ms) {
+    audio_voice_t *voice = audio_find_voice(gpio);
+
+    if (voice == NULL) {
+        return false;
+    }
+
+    // Acima de metade da taxa de amostragem a nota seria rebatida para outra frequência
+    if (frequency > AUDIO_SAMPLE_RATE / 2) {
+        frequency = AUDIO_SAMPLE_RATE / 2;
+    }
+
+    audio_note_t note = {
+        .phase_step = frequency * AUDIO_PHASE_PER_HZ,
+        .duration_ms = duration_ms,
+        .instrument = voice->instrument
+    };
+    return audio_enqueue(voice, &note);
+}
+
+bool audio_play_note(uint gpio, const audio_instrument_t *instrument, uint midi_note, uint32_t duration_ms) {
+    audio_note_t note = {
+        .phase_step = midi_note < AUDIO_MIDI_NOTES ? audio_pitch_table[midi_note] : 0,
+        .duration_ms = duration_ms,
+        .instrument = instrument
+    };
+    return audio_enqueue(audio_find_voice(gpio), &note);
+}
+
+void audio_stop(uint gpio) {
+    audio_voice_t *voice = audio_find_voice(gpio);
+
+    if (voice == NULL) {
+        return;
+    }
+    // A fila é esvaziada aqui para que notas enfileiradas logo depois não sejam descartadas
+    xQueueReset(voice->notes);
+    xTimerPendFunctionCall(audio_service, voice, AUDIO_SILENCE, portMAX_DELAY);
+}
+
+void audio_stop_all(void) {
+    for (uint i = 0; i < audio_voice_count; i++) {
+        audio_stop(audio_voices[i].gpio);
+    }
+}
@@ -0,0 +1,56 @@
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+
+#ifndef audio_inc_h
+#define audio_inc_h
+
+// Quantidade de buzzers tocando de forma independente (cada um com sua fila de notas)
+#define AUDIO_MAX_VOICES    2
+// Notas que podem aguardar na fila de cada buzzer
+#define AUDIO_QUEUE_LENGTH  8
+
+// Timbre de uma nota: forma de onda (AUDIO_WAVE_* de audio_tables.h), volume (0 a AUDIO_VOLUME_STEPS - 1)
+// e envoltória ADSR: subida até o máximo, queda até o nível de sustentação (0 a 255) e extinção depois do
+// fim da nota. Durações em milissegundos; 0 é instantâneo
+typedef struct {
+    uint8_t wave;
+    uint8_t volume;
+    uint8_t sustain;
+    uint16_t attack_ms;
+    uint16_t decay_ms;
+    uint16_t release_ms;
+} audio_instrument_t;
+
+// Instrumentos prontos: bipe quadrado curto, sino (senoide com queda longa) e tom suave de órgão
+extern const audio_instrument_t audio_instrument_beep;
+extern const audio_instrument_t audio_instrument_bell;
+extern const audio_instrument_t audio_instrument_soft;
+
+// Nota de uma fila: incremento de fase por amostra (Q32; 0 é pausa), duração em milissegundos e timbre
+typedef struct {
+    uint32_t phase_step;
+    uint32_t duration_ms;
+    const audio_instrument_t *instrument;
+} audio_note_t;
+
+// Configura os pinos como saída de áudio (um buzzer por pino, amostras via DMA) e cria as filas e timers das vozes
+// e a tarefa que calcula as amostras, nos núcleos de core_mask
+void audio_init(const uint *pins, uint count, UBaseType_t core_mask);
+
+// Troca o instrumento usado por audio_play no buzzer (o padrão é audio_instrument_beep)
+void audio_set_instrument(uint gpio, const audio_instrument_t *instrument);
+
+// Enfileira uma nota no buzzer e retorna imediatamente; falso se a fila estiver cheia.
+// As notas são tocadas em sequência pelo timer de software do FreeRTOS
+bool audio_play(uint gpio, uint32_t frequency, uint32_t duration_ms);
+
+// Como audio_play, com a altura dada como nota MIDI (60 = dó central, 69 = lá 440 Hz) e o timbre da nota
+bool audio_play_note(uint gpio, const audio_instrument_t *instrument, uint midi_note, uint32_t duration_ms);
+
+// Silencia o buzzer e descarta as notas enfileiradas
+void audio_stop(uint gpio);
+
+// Silencia todos os buzzers
+void audio_stop_all(void);
+
+#endif
@@ -0,0 +1,283 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "hardware/pwm.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/clocks.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "audio_dma.h"
+#include "audio_tables.h"
+#include "rtos_alloc.h"
+
+// Maior numerador do divisor fracionário dos timers de DMA que ainda cabe a procura em audio_dma_set_rate
+#define AUDIO_DMA_MAX_NUMERATOR 16
+
+// A tarefa do áudio tem um bloco (4 ms) para preencher o que terminou: fica logo abaixo do timer de software
+#ifndef AUDIO_DMA_STACK_DEPTH
+#define AUDIO_DMA_STACK_DEPTH   (configMINIMAL_STACK_SIZE + 128)
+#endif
+#define AUDIO_DMA_PRIORITY      (configMAX_PRIORITIES - 2)
+
+// Saída de áudio: os dois blocos e seus canais; o canal i toca blocks[i] e, ao terminar, dispara o outro
+typedef struct {
+    uint16_t blocks[2][AUDIO_BLOCK_SAMPLES];
+    uint channels[2];
+} audio_dma_output_t;
+
+// Estados do transporte. Parado, nenhum canal nem o timer correm e a interrupção não acontece; a parada e a
+// volta passam por rampas entre o nível 0 (buzzer sem corrente) e o silêncio no centro, sem estalo
+enum {
+    AUDIO_DMA_STOPPED,
+    AUDIO_DMA_RUNNING,
+    AUDIO_DMA_RAMPING,          // A rampa de descida está na fila do DMA
+    AUDIO_DMA_DRAINING          // A rampa está tocando; depois dela, só zeros
+};
+
+static audio_dma_output_t audio_dma_outputs[AUDIO_MAX_OUTPUTS];
+static uint audio_dma_output_count = 0;
+static audio_dma_fill_t audio_dma_fill = NULL;
+static TaskHandle_t audio_dma_task_handle = NULL;
+static uint audio_dma_timer;
+static uint16_t audio_dma_timer_x, audio_dma_timer_y;  // Fração do timer na taxa de amostragem
+static uint32_t audio_dma_channel_mask = 0;             // Todos os canais das saídas
+static uint8_t audio_dma_state = AUDIO_DMA_STOPPED;
+static uint audio_dma_quiet_blocks = 0;                 // Blocos seguidos de silêncio em todas as saídas
+
+RTOS_TASK_STORAGE(audio_dma, AUDIO_DMA_STACK_DEPTH);
+
+// Bit da notificação da tarefa do áudio que pede o preenchimento do bloco b da saída o
+#define AUDIO_DMA_BLOCK_BIT(o, b)   (1u << ((o) * 2 + (b)))
+// Bit da notificação que pede a volta do DMA parado (audio_dma_start)
+#define AUDIO_DMA_START_BIT         (1u << 31)
+
+// Fim de um bloco: o canal encadeado já está tocando o outro. O canal que terminou volta para o início do seu
+// bloco (sem disparar; quem o dispara é o encadeamento) e a tarefa do áudio é avisada para preenchê-lo.
+// A contagem de transferências é recarregada sozinha a cada disparo
+static void audio_dma_irq(void) {
+    uint32_t finished = 0;
+    BaseType_t woken = pdFALSE;
+
+    for (uint o = 0; o < audio_dma_output_count; o++) {
+        audio_dma_output_t *output = &audio_dma_outputs[o];
+
+        for (uint b = 0; b < 2; b++) {
+            uint channel = output->channels[b];
+
+            if (dma_channel_get_irq1_status(channel)) {
+                dma_channel_acknowledge_irq1(channel);
+                dma_channel_set_read_addr(channel, output->blocks[b], false);
+                finished |= AUDIO_DMA_BLOCK_BIT(o, b);
+            }
+        }
+    }
+
+    if (finished != 0) {
+        xTaskNotifyFromISR(audio_dma_task_handle, finished, eSetBits, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+// Soma ao bloco uma rampa linear que desloca a primeira amostra de from e a última de exatamente to
+static void audio_dma_ramp(uint16_t *block, int from, int to) {
+    for (uint i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+        int32_t sample = block[i] + from + (to - from) * (int)(i + 1) / AUDIO_BLOCK_SAMPLES;
+
+        block[i] = sample < 0 ? 0 : sample > AUDIO_PWM_WRAP ? AUDIO_PWM_WRAP : (uint16_t)sample;
+    }
+}
+
+// Para os canais e o timer; o último nível escrito no PWM foi 0
+static void audio_dma_stop(void) {
+    for (uint o = 0; o < audio_dma_output_count; o++) {
+        for (uint b = 0; b < 2; b++) {
+            dma_channel_set_irq1_enabled(audio_dma_outputs[o].channels[b], false);
+        }
+    }
+    // O abort pode acionar a interrupção do canal (errata RP2040-E13): ela já está desligada e é descartada
+    dma_hw->abort = audio_dma_channel_mask;
+    while (dma_hw->abort & audio_dma_channel_mask) {
+        tight_loop_contents();
+    }
+    dma_hw->ints1 = audio_dma_channel_mask;
+    dma_timer_set_fraction(audio_dma_timer, 0, 0);
+
+    audio_dma_state = AUDIO_DMA_STOPPED;
+}
+
+// Volta a tocar a partir do nível 0: o primeiro bloco de cada saída sobe em rampa até o centro junto com o
+// começo das notas novas, então a volta não atrasa o som
+static void audio_dma_restart(void) {
+    uint32_t start_mask = 0;
+
+    for (uint o = 0; o < audio_dma_output_count; o++) {
+        audio_dma_output_t *output = &audio_dma_outputs[o];
+
+        audio_dma_fill(o, output->blocks[0], AUDIO_BLOCK_SAMPLES);
+        audio_dma_ramp(output->blocks[0], -AUDIO_CENTER_LEVEL, 0);
+        audio_dma_fill(o, output->blocks[1], AUDIO_BLOCK_SAMPLES);
+
+        for (uint b = 0; b < 2; b++) {
+            uint channel = output->channels[b];
+
+            dma_channel_set_read_addr(channel, output->blocks[b], false);
+            dma_channel_set_trans_count(channel, AUDIO_BLOCK_SAMPLES, false);
+            dma_channel_acknowledge_irq1(channel);
+            dma_channel_set_irq1_enabled(channel, true);
+        }
+        start_mask |= 1u << output->channels[0];
+    }
+
+    audio_dma_quiet_blocks = 0;
+    audio_dma_state = AUDIO_DMA_RUNNING;
+    dma_timer_set_fraction(audio_dma_timer, audio_dma_timer_x, audio_dma_timer_y);
+
+    // As saídas começam juntas e seguem o mesmo timer, então ficam sempre alinhadas
+    dma_start_channel_mask(start_mask);
+}
+
+// O bloco b de todas as saídas terminou de tocar (o outro está tocando): preenche-o ou avança a parada
+static void audio_dma_block_done(uint b) {
+    bool sound = false;
+
+    switch (audio_dma_state) {
+    case AUDIO_DMA_RUNNING:
+        for (uint o = 0; o < audio_dma_output_count; o++) {
+            if (audio_dma_fill(o, audio_dma_outputs[o].blocks[b], AUDIO_BLOCK_SAMPLES)) {
+                sound = true;
+            }
+        }
+        audio_dma_quiet_blocks = sound ? 0 : audio_dma_quiet_blocks + 1;
+
+        // Os dois blocos de todas as saídas são silêncio: este passa a descer até o nível 0
+        if (audio_dma_quiet_blocks >= 2) {
+            for (uint o = 0; o < audio_dma_output_count; o++) {
+                audio_dma_ramp(audio_dma_outputs[o].blocks[b], 0, -AUDIO_CENTER_LEVEL);
+            }
+            audio_dma_state = AUDIO_DMA_RAMPING;
+        }
+        break;
+    case AUDIO_DMA_RAMPING:
+        for (uint o = 0; o < audio_dma_output_count; o++) {
+            memset(audio_dma_outputs[o].blocks[b], 0, sizeof(audio_dma_outputs[o].blocks[b]));
+        }
+        audio_dma_state = AUDIO_DMA_DRAINING;
+        break;
+    case AUDIO_DMA_DRAINING:
+        audio_dma_stop();
+        break;
+    default:
+        break;
+    }
+}
+
+// Preenche os blocos que terminaram de tocar com as próximas amostras do sintetizador; com todas as saídas em
+// silêncio, para o DMA até a próxima nota
+static void audio_dma_task(void *params) {
+    bool start = false;
+
+    for (;;) {
+        uint32_t events;
+
+        xTaskNotifyWait(0, UINT32_MAX, &events, portMAX_DELAY);
+        for (uint b = 0; b < 2; b++) {
+            if (events & (AUDIO_DMA_BLOCK_BIT(0, b) | AUDIO_DMA_BLOCK_BIT(1, b))) {
+                audio_dma_block_done(b);
+            }
+        }
+
+        // Uma nota pedida durante a parada espera ela terminar (no máximo dois blocos)
+        start = start || (events & AUDIO_DMA_START_BIT) != 0;
+        if (start && audio_dma_state == AUDIO_DMA_STOPPED) {
+            audio_dma_restart();
+        }
+        if (audio_dma_state == AUDIO_DMA_RUNNING) {
+            start = false;
+        }
+    }
+}
+
+// Timer de DMA na taxa de amostragem: clk_sys * X / Y, com Y de 16 bits. Procura o X que dá a taxa exata
+// (a 125 MHz e 32 kHz, 4 / 15625) ou a mais próxima; o clock é lido do sistema em vez de suposto
+static void audio_dma_set_rate(uint32_t sample_rate) {
+    uint64_t clock_hz = clock_get_hz(clk_sys);
+    uint32_t best_x = 1, best_y = 0xffff;
+    uint64_t best_error = UINT64_MAX;
+
+    for (uint32_t x = 1; x <= AUDIO_DMA_MAX_NUMERATOR; x++) {
+        uint64_t y = (clock_hz * x + sample_rate / 2) / sample_rate;
+
+        if (y == 0 || y > 0xffff) {
+            break;
+        }
+
+        uint64_t rate = clock_hz * x / y;
+        uint64_t error = rate > sample_rate ? rate - sample_rate : sample_rate - rate;
+        if (error < best_error) {
+            best_error = error;
+            best_x = x;
+            best_y = (uint32_t)y;
+        }
+        if (error == 0 && clock_hz * x % y == 0) {
+            break;
+        }
+    }
+
+    audio_dma_timer_x = (uint16_t)best_x;
+    audio_dma_timer_y = (uint16_t)best_y;
+}
+
+void audio_dma_init(const uint *pins, uint count, uint32_t sample_rate, audio_dma_fill_t fill, UBaseType_t core_mask) {
+    assert(count <= AUDIO_MAX_OUTPUTS);
+    audio_dma_fill = fill;
+    audio_dma_timer = dma_claim_unused_timer(true);
+    audio_dma_set_rate(sample_rate);
+
+    for (uint o = 0; o < count; o++) {
+        audio_dma_output_t *output = &audio_dma_outputs[o];
+        uint slice = pwm_gpio_to_slice_num(pins[o]);
+
+        // Portadora em clk_sys / (AUDIO_PWM_WRAP + 1), 488 kHz a 125 MHz: bem acima do audível.
+        // O nível 0 deixa o buzzer sem corrente até a primeira nota
+        gpio_set_function(pins[o], GPIO_FUNC_PWM);
+        pwm_config config = pwm_get_default_config();
+        pwm_config_set_clkdiv_int(&config, 1);
+        pwm_config_set_wrap(&config, AUDIO_PWM_WRAP);
+        pwm_init(slice, &config, true);
+
+        output->channels[0] = dma_claim_unused_channel(true);
+        output->channels[1] = dma_claim_unused_channel(true);
+
+        for (uint b = 0; b < 2; b++) {
+            uint channel = output->channels[b];
+
+            // Escritas de 16 bits no registrador CC são replicadas nas duas metades (canais A e B do slice).
+            // O outro pino de cada slice dos buzzers não usa PWM, então basta escrever o nível como está
+            dma_channel_config dma_config = dma_channel_get_default_config(channel);
+            channel_config_set_transfer_data_size(&dma_config, DMA_SIZE_16);
+            channel_config_set_read_increment(&dma_config, true);
+            channel_config_set_write_increment(&dma_config, false);
+            channel_config_set_dreq(&dma_config, dma_get_timer_dreq(audio_dma_timer));
+            channel_config_set_chain_to(&dma_config, output->channels[1 - b]);
+            dma_channel_configure(channel, &dma_config, &pwm_hw->slice[slice].cc, output->blocks[b],
+                                  AUDIO_BLOCK_SAMPLES, false);
+            audio_dma_channel_mask |= 1u << channel;
+        }
+    }
+    audio_dma_output_count = count;
+
+    audio_dma_task_handle = RTOS_TASK_CREATE(audio_dma, audio_dma_task, "Audio", AUDIO_DMA_STACK_DEPTH, NULL,
+                                             AUDIO_DMA_PRIORITY, core_mask);
+
+    // Prioridade mínima: a interrupção nunca atrasa a marcação de tempo dos botões (GPIO)
+    irq_set_exclusive_handler(DMA_IRQ_1, audio_dma_irq);
+    irq_set_priority(DMA_IRQ_1, PICO_LOWEST_IRQ_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    // Os canais e o timer ficam parados até a primeira nota (audio_dma_start)
+}
+
+void audio_dma_start(void) {
+    xTaskNotify(audio_dma_task_handle, AUDIO_DMA_START_BIT, eSetBits);
+}
@@ -0,0 +1,30 @@
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+
+#ifndef audio_dma_inc_h
+#define audio_dma_inc_h
+
+// Transporte das amostras do sintetizador (src/audio.c) até os buzzers: cada pino é uma saída PWM de 8 bits
+// cujo nível é trocado a cada amostra por um canal DMA, no ritmo de um timer de DMA. Dois blocos por saída
+// se revezam (canais encadeados): enquanto o DMA toca um, a tarefa do áudio preenche o outro. A interrupção
+// do DMA só rearma o canal que terminou e acorda a tarefa; nenhuma amostra é calculada nela. Com todas as
+// saídas em silêncio, o transporte desce até o nível 0 e para os canais e o timer, sem interrupções.
+// No host, host/audio_dma_host.c substitui o hardware
+
+#define AUDIO_BLOCK_SAMPLES     128     // Amostras por bloco (4 ms a 32 kHz): limita o atraso do início de uma nota
+#define AUDIO_MAX_OUTPUTS       2
+#define AUDIO_CENTER_LEVEL      128     // Nível do PWM para a amostra 0: o silêncio com o DMA tocando
+
+// Preenche um bloco da saída (índice em pins) com níveis de 0 a AUDIO_PWM_WRAP e retorna falso se o bloco é só
+// silêncio (AUDIO_CENTER_LEVEL); chamada na tarefa do áudio
+typedef bool (*audio_dma_fill_t)(uint output, uint16_t *block, uint count);
+
+// Configura o PWM dos pinos (nível 0), os canais DMA e o timer de ritmo e cria a tarefa do áudio nos núcleos de
+// core_mask. O DMA fica parado até audio_dma_start
+void audio_dma_init(const uint *pins, uint count, uint32_t sample_rate, audio_dma_fill_t fill, UBaseType_t core_mask);
+
+// Volta a tocar blocos se o DMA parou no silêncio (com uma rampa do nível 0 até o centro, sem estalo). Chamada
+// ao ligar uma nota, em tarefa (não em interrupção)
+void audio_dma_start(void);
+
+#endif
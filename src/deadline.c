@@ -0,0 +1,34 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "deadline.h"
+
+void deadline_stats_reset(deadline_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+}
+
+void deadline_stats_record(deadline_stats_t *stats, uint64_t deadline_us, uint64_t actual_us) {
+    stats->count++;
+
+    if (actual_us >= deadline_us) {
+        uint32_t late_us = (uint32_t)(actual_us - deadline_us);
+
+        stats->late_sum_us += late_us;
+        if (late_us > stats->late_max_us) {
+            stats->late_max_us = late_us;
+        }
+    }
+    else {
+        uint32_t early_us = (uint32_t)(deadline_us - actual_us);
+
+        if (early_us > stats->early_max_us) {
+            stats->early_max_us = early_us;
+        }
+    }
+}
+
+void deadline_stats_print(const char *name, const deadline_stats_t *stats) {
+    printf("jitter,%s,%lu,%lu,%lu,%lu\n", name, (unsigned long)stats->count,
+           (unsigned long)(stats->count > 0 ? stats->late_sum_us / stats->count : 0),
+           (unsigned long)stats->late_max_us, (unsigned long)stats->early_max_us);
+}
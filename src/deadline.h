@@ -0,0 +1,26 @@
+#include "pico/stdlib.h"
+
+#ifndef deadline_inc_h
+#define deadline_inc_h
+
+// Atraso de eventos agendados em prazos absolutos (timer de 1 Hz da contagem, vTaskDelayUntil entre as rodadas).
+// Cada amostra compara o instante em que o evento aconteceu com o prazo calculado a partir de uma referência
+// fixa, então o atraso de um evento não se soma aos seguintes. Os prazos andam em ticks (1 ms); atrasos e
+// adiantamentos menores que um tick são a quantização do tick, não deriva
+
+typedef struct {
+    uint32_t count;
+    uint32_t late_max_us;       // Maior atraso em relação ao prazo
+    uint32_t early_max_us;      // Maior adiantamento em relação ao prazo
+    uint64_t late_sum_us;       // Soma dos atrasos (adiantamentos contam como zero)
+} deadline_stats_t;
+
+void deadline_stats_reset(deadline_stats_t *stats);
+
+// Registra um evento que devia acontecer em deadline_us e aconteceu em actual_us (base de time_us_64)
+void deadline_stats_record(deadline_stats_t *stats, uint64_t deadline_us, uint64_t actual_us);
+
+// Envia pela saída padrão (USB): jitter,<nome>,<amostras>,<atraso_medio_us>,<atraso_max_us>,<adiantado_max_us>
+void deadline_stats_print(const char *name, const deadline_stats_t *stats);
+
+#endif
@@ -0,0 +1,108 @@
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "game_state.h"
+#include "rtos_alloc.h"
+
+// Seqlock: game_state_sequence fica ímpar enquanto uma escrita está em andamento. Os campos são lidos e
+// escritos um a um com acesso atômico relaxado; a ordem entre eles e a sequência vem das barreiras
+static game_state_snapshot_t game_state_current;
+static uint32_t game_state_sequence = 0;
+
+RTOS_EVENT_GROUP_STORAGE(game_state);
+static EventGroupHandle_t game_state_events = NULL;
+
+// Escritores: a seção crítica serializa a tarefa do jogo e o timer da contagem e impede que a escrita seja
+// interrompida no meio, então um leitor no mesmo núcleo nunca vê a sequência ímpar e um no outro núcleo
+// repete a cópia no máximo pelo tempo de algumas instruções
+static void game_state_write_begin(void) {
+    taskENTER_CRITICAL();
+    __atomic_store_n(&game_state_sequence, game_state_sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);    // Sequência ímpar visível antes dos campos novos
+}
+
+static void game_state_write_end(void) {
+    __atomic_store_n(&game_state_current.version, game_state_current.version + 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&game_state_sequence, game_state_sequence + 1, __ATOMIC_RELEASE);
+    taskEXIT_CRITICAL();
+}
+
+void game_state_snapshot(game_state_snapshot_t *snapshot) {
+    uint32_t before, after;
+
+    do {
+        before = __atomic_load_n(&game_state_sequence, __ATOMIC_ACQUIRE);
+        snapshot->version = __atomic_load_n(&game_state_current.version, __ATOMIC_RELAXED);
+        snapshot->score = __atomic_load_n(&game_state_current.score, __ATOMIC_RELAXED);
+        snapshot->seconds_left = __atomic_load_n(&game_state_current.seconds_left, __ATOMIC_RELAXED);
+        snapshot->over = __atomic_load_n(&game_state_current.over, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);  // Campos lidos antes de conferir a sequência de novo
+        after = __atomic_load_n(&game_state_sequence, __ATOMIC_RELAXED);
+    } while ((before & 1) != 0 || before != after);
+}
+
+void game_state_init(int seconds) {
+    if (game_state_events == NULL) {
+        game_state_events = RTOS_EVENT_GROUP_CREATE(game_state);
+        configASSERT(game_state_events != NULL);
+    }
+    xEventGroupClearBits(game_state_events, GAME_EVENT_OVER | GAME_EVENT_SUMMARY_READY);
+
+    game_state_write_begin();
+    __atomic_store_n(&game_state_current.score, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&game_state_current.seconds_left, seconds, __ATOMIC_RELAXED);
+    __atomic_store_n(&game_state_current.over, false, __ATOMIC_RELAXED);
+    game_state_write_end();
+}
+
+int game_state_score(void) {
+    game_state_snapshot_t snapshot;
+    game_state_snapshot(&snapshot);
+    return snapshot.score;
+}
+
+int game_state_add_point(void) {
+    game_state_write_begin();
+    int score = game_state_current.score + 1;
+    __atomic_store_n(&game_state_current.score, score, __ATOMIC_RELAXED);
+    game_state_write_end();
+    return score;
+}
+
+int game_state_seconds_left(void) {
+    game_state_snapshot_t snapshot;
+    game_state_snapshot(&snapshot);
+    return snapshot.seconds_left;
+}
+
+int game_state_tick_second(void) {
+    game_state_write_begin();
+    int seconds = game_state_current.seconds_left;
+    if (seconds > 0) {
+        seconds--;
+        __atomic_store_n(&game_state_current.seconds_left, seconds, __ATOMIC_RELAXED);
+    }
+    game_state_write_end();
+    return seconds;
+}
+
+bool game_state_is_over(void) {
+    return (xEventGroupGetBits(game_state_events) & GAME_EVENT_OVER) != 0;
+}
+
+// O retrato é publicado antes do evento, então quem acorda com GAME_EVENT_OVER já lê over verdadeiro
+void game_state_set_over(void) {
+    game_state_write_begin();
+    __atomic_store_n(&game_state_current.over, true, __ATOMIC_RELAXED);
+    game_state_write_end();
+    game_state_signal(GAME_EVENT_OVER);
+}
+
+void game_state_signal(EventBits_t events) {
+    xEventGroupSetBits(game_state_events, events);
+}
+
+bool game_state_wait(EventBits_t events, TickType_t timeout) {
+    EventBits_t bits = xEventGroupWaitBits(game_state_events, events, pdFALSE, pdTRUE, timeout);
+    return (bits & events) == events;
+}
@@ -0,0 +1,53 @@
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "event_groups.h"
+
+#ifndef game_state_inc_h
+#define game_state_inc_h
+
+// Estado do jogo compartilhado entre as tarefas (e, no modo SMP, entre os dois núcleos).
+// Pontuação, tempo restante e fim de jogo são publicados juntos em um seqlock: quem escreve (a tarefa do
+// jogo e o timer da contagem) faz a atualização inteira dentro de uma seção crítica curta, sem esperar por
+// ninguém, e quem lê (display, placar, telemetria) copia um retrato coerente sem trava, repetindo a cópia
+// só se ela coincidiu com uma escrita. As fases da partida também ficam em um grupo de eventos, que as
+// tarefas podem esperar sem varredura
+
+// Eventos da partida
+#define GAME_EVENT_OVER            (1 << 0) // A contagem chegou a zero
+#define GAME_EVENT_SUMMARY_READY   (1 << 1) // A tarefa do jogo publicou o resumo das estatísticas
+
+// Retrato do estado em um instante; version conta as publicações (muda a cada alteração)
+typedef struct {
+    uint32_t version;
+    int score;
+    int seconds_left;
+    bool over;
+} game_state_snapshot_t;
+
+// Reinicia a partida com a pontuação zerada e o tempo indicado
+void game_state_init(int seconds);
+
+// Copia o estado atual sem trava; os três campos sempre vêm da mesma publicação
+void game_state_snapshot(game_state_snapshot_t *snapshot);
+
+int game_state_score(void);
+
+// Soma um acerto e retorna a nova pontuação
+int game_state_add_point(void);
+
+int game_state_seconds_left(void);
+
+// Desconta um segundo da contagem e retorna o tempo restante
+int game_state_tick_second(void);
+
+bool game_state_is_over(void);
+
+void game_state_set_over(void);
+
+// Sinaliza eventos da partida (GAME_EVENT_*)
+void game_state_signal(EventBits_t events);
+
+// Bloqueia até todos os eventos pedidos ou até o timeout; retorna falso no timeout
+bool game_state_wait(EventBits_t events, TickType_t timeout);
+
+#endif
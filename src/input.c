@@ -0,0 +1,63 @@
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "input.h"
+#include "rtos_alloc.h"
+#include "trace.h"
+
+#define INPUT_MAX_GPIO 30
+
+RTOS_QUEUE_STORAGE(input, INPUT_QUEUE_LENGTH, sizeof(input_event_t));
+static QueueHandle_t input_queue = NULL;
+// Instante da última borda (subida ou descida) de cada pino, para o filtro de trepidação
+static uint64_t input_last_edge_us[INPUT_MAX_GPIO];
+
+// Tratador das interrupções de GPIO: registra o instante e filtra a trepidação dos contatos.
+// Um aperto só é aceito se o pino ficou INPUT_DEBOUNCE_US sem bordas; assim tanto a trepidação
+// do aperto quanto a da soltura (que também gera bordas de descida) são descartadas
+static void input_gpio_callback(uint gpio, uint32_t events) {
+    uint64_t now = time_us_64();
+
+    TRACE_ISR(TRACE_ISR_GPIO);
+
+    if (gpio >= INPUT_MAX_GPIO) {
+        return;
+    }
+
+    uint64_t quiet_us = now - input_last_edge_us[gpio];
+    input_last_edge_us[gpio] = now;
+
+    if ((events & GPIO_IRQ_EDGE_FALL) && quiet_us >= INPUT_DEBOUNCE_US) {
+        input_event_t event = {
+            .gpio = gpio,
+            .timestamp_us = now
+        };
+        BaseType_t woken = pdFALSE;
+
+        xQueueSendFromISR(input_queue, &event, &woken); // Fila cheia: o aperto é descartado
+        portYIELD_FROM_ISR(woken);
+    }
+}
+
+void input_init(const uint *pins, uint count) {
+    input_queue = RTOS_QUEUE_CREATE(input, INPUT_QUEUE_LENGTH, sizeof(input_event_t));
+    configASSERT(input_queue != NULL);
+
+    for (uint i = 0; i < count; i++) {
+        gpio_init(pins[i]);
+        gpio_set_dir(pins[i], false);
+        gpio_pull_up(pins[i]);
+
+        // O SDK tem um único callback de GPIO por núcleo; ele é registrado na primeira chamada
+        gpio_set_irq_enabled_with_callback(pins[i], GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, input_gpio_callback);
+    }
+}
+
+void input_flush(void) {
+    xQueueReset(input_queue);
+}
+
+bool input_wait(input_event_t *event, TickType_t timeout) {
+    return xQueueReceive(input_queue, event, timeout) == pdTRUE;
+}
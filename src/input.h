@@ -0,0 +1,27 @@
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+
+#ifndef input_inc_h
+#define input_inc_h
+
+// Tempo mínimo sem nenhuma borda no pino para aceitar um novo aperto (filtro de trepidação)
+#define INPUT_DEBOUNCE_US   20000
+// Quantidade de eventos que podem aguardar na fila até a tarefa do jogo consumi-los
+#define INPUT_QUEUE_LENGTH  16
+
+// Aperto de botão, com o instante da borda de descida medido pelo timer de 1 MHz
+typedef struct {
+    uint gpio;
+    uint64_t timestamp_us;
+} input_event_t;
+
+// Configura as interrupções de borda dos pinos (com pull-up) e cria a fila de eventos
+void input_init(const uint *pins, uint count);
+
+// Descarta os apertos ainda não consumidos
+void input_flush(void);
+
+// Bloqueia até o próximo aperto ou até o timeout; retorna falso no timeout
+bool input_wait(input_event_t *event, TickType_t timeout);
+
+#endif
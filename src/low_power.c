@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/timer.h"
+#include "hardware/sync.h"
+#include "hardware/structs/systick.h"
+#include "hardware/structs/scb.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "low_power.h"
+#include "rtos_alloc.h"
+
+#if configUSE_TICKLESS_IDLE == 2
+
+#define LOW_POWER_US_PER_TICK   (1000000U / configTICK_RATE_HZ)
+
+static uint low_power_alarm;
+static uint32_t low_power_cycles_per_tick;  // Período do SysTick configurado pelo port
+static uint32_t low_power_cycles_per_us;
+
+static low_power_stats_t low_power_stats;
+
+#if defined(REFLEX_TICKLESS_REPORT) && REFLEX_TICKLESS_REPORT
+RTOS_TASK_STORAGE(low_power_report, configMINIMAL_STACK_SIZE + 256);
+#endif
+
+// O alarme só precisa tirar o processador do WFI
+static void low_power_alarm_callback(uint alarm) {
+    (void)alarm;
+}
+
+#if defined(REFLEX_TICKLESS_REPORT) && REFLEX_TICKLESS_REPORT
+// Modo de medição: despertares da tarefa ociosa por segundo (em décimos) e fração do tempo dormindo
+// (em permil) no último intervalo: idle,<despertares/s x10>,<permil dormindo>,<antecipados>,<cancelados>
+static void low_power_report_task(void *params) {
+    low_power_stats_t last = {0};
+    low_power_stats_t now;
+    TickType_t last_wake = xTaskGetTickCount();
+
+    for (;;) {
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(LOW_POWER_REPORT_MS));
+
+        low_power_get_stats(&now);
+        printf("idle,%lu,%lu,%lu,%lu\n",
+               (unsigned long)((now.sleeps - last.sleeps) * 10000ULL / LOW_POWER_REPORT_MS),
+               (unsigned long)((now.slept_us - last.slept_us) / LOW_POWER_REPORT_MS),
+               (unsigned long)(now.early_wakeups - last.early_wakeups),
+               (unsigned long)(now.aborted - last.aborted));
+        last = now;
+    }
+}
+#endif
+
+void low_power_init(void) {
+    low_power_alarm = (uint)hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(low_power_alarm, low_power_alarm_callback);
+
+#if defined(REFLEX_TICKLESS_REPORT) && REFLEX_TICKLESS_REPORT
+    RTOS_TASK_CREATE(low_power_report, low_power_report_task, "Idle Report", configMINIMAL_STACK_SIZE + 256, NULL, tskIDLE_PRIORITY, RTOS_ANY_CORE);
+#endif
+}
+
+void low_power_get_stats(low_power_stats_t *stats) {
+    taskENTER_CRITICAL();
+    *stats = low_power_stats;
+    taskEXIT_CRITICAL();
+}
+
+// Chamada pela tarefa ociosa (portSUPPRESS_TICKS_AND_SLEEP) com o agendador suspenso
+void vPortSuppressTicksAndSleep(TickType_t expected_idle_ticks) {
+    uint32_t interrupts = save_and_disable_interrupts();
+
+    // Pausa o SysTick. O COUNTFLAG do CSR não serve para achar um tick pendente: o tratador do port
+    // não lê o CSR, então a flag continua marcada por voltas já atendidas desde o último sono
+    uint32_t csr = systick_hw->csr;
+    systick_hw->csr = csr & ~M0PLUS_SYST_CSR_ENABLE_BITS;
+
+    if (eTaskConfirmSleepModeStatus() == eAbortSleep) {
+        systick_hw->csr = csr | M0PLUS_SYST_CSR_ENABLE_BITS; // Continua de onde parou
+        low_power_stats.aborted++;
+        restore_interrupts(interrupts);
+        return;
+    }
+
+    if (low_power_cycles_per_tick == 0) {
+        low_power_cycles_per_tick = systick_hw->rvr + 1;
+        low_power_cycles_per_us = low_power_cycles_per_tick / LOW_POWER_US_PER_TICK;
+    }
+
+    // Tempo já decorrido desde o último tick contado pelo kernel. Um tick pendente (o SysTick deu a
+    // volta com as interrupções desligadas, PENDSTSET no ICSR) é descartado aqui e contado no vTaskStepTick
+    uint64_t since_tick_us = (low_power_cycles_per_tick - systick_hw->cvr) / low_power_cycles_per_us;
+    if (scb_hw->icsr & M0PLUS_ICSR_PENDSTSET_BITS) {
+        scb_hw->icsr = M0PLUS_ICSR_PENDSTCLR_BITS;
+        since_tick_us += LOW_POWER_US_PER_TICK;
+    }
+
+    uint64_t sleep_start_us = time_us_64();
+    uint64_t wake_target_us = sleep_start_us + (uint64_t)expected_idle_ticks * LOW_POWER_US_PER_TICK - since_tick_us;
+
+    // Alarme no próximo evento de tempo do kernel; se ele já passou, não dorme
+    bool missed = hardware_alarm_set_target(low_power_alarm, from_us_since_boot(wake_target_us));
+    if (!missed) {
+        __wfi();                // Acorda com o alarme ou com qualquer outra interrupção pendente
+    }
+    hardware_alarm_cancel(low_power_alarm);
+
+    uint64_t now_us = time_us_64();
+    uint64_t total_us = since_tick_us + (now_us - sleep_start_us);
+    TickType_t ticks = total_us / LOW_POWER_US_PER_TICK;
+
+    if (ticks > expected_idle_ticks) {
+        ticks = expected_idle_ticks; // O kernel não aceita passar do próximo desbloqueio
+    }
+    uint64_t remainder_us = total_us - (uint64_t)ticks * LOW_POWER_US_PER_TICK;
+    if (remainder_us >= LOW_POWER_US_PER_TICK) {
+        remainder_us = LOW_POWER_US_PER_TICK - 1;
+    }
+
+    low_power_stats.sleeps++;
+    low_power_stats.slept_us += now_us - sleep_start_us;
+    if (now_us < wake_target_us) {
+        low_power_stats.early_wakeups++;
+    }
+
+    // O primeiro período após o sono dura só o que falta da fração de tick, mantendo a fase do tick
+    // alinhada ao timer de 1 MHz; o período normal volta a valer na recarga seguinte
+    systick_hw->rvr = (LOW_POWER_US_PER_TICK - remainder_us) * low_power_cycles_per_us - 1;
+    systick_hw->cvr = 0;
+    systick_hw->csr = csr | M0PLUS_SYST_CSR_ENABLE_BITS;
+
+    vTaskStepTick(ticks);
+
+    systick_hw->rvr = low_power_cycles_per_tick - 1;
+    restore_interrupts(interrupts);
+}
+
+#endif
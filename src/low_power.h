@@ -0,0 +1,37 @@
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+
+#ifndef low_power_inc_h
+#define low_power_inc_h
+
+// Modo tickless (cmake -DREFLEX_TICKLESS=ON): quando todas as tarefas estão bloqueadas, a tarefa ociosa
+// desliga o SysTick e dorme em WFI até o próximo evento de tempo do kernel (um alarme do timer de 1 MHz)
+// ou até qualquer interrupção (botões, I2C, USB). Ao acordar, o tick é corrigido com o tempo medido,
+// guardando a fração de tick para que a contagem regressiva não acumule erro.
+// Só existe no RP2040 com um núcleo; no SMP e no host o tick continua periódico
+
+// Intervalo do relatório do modo de medição (REFLEX_TICKLESS_REPORT)
+#define LOW_POWER_REPORT_MS     10000
+
+// Contadores do modo tickless desde a inicialização
+typedef struct {
+    uint32_t sleeps;            // Vezes que o processador dormiu (= despertares da tarefa ociosa)
+    uint32_t early_wakeups;     // Despertares por interrupção antes do alarme
+    uint32_t aborted;           // Tentativas canceladas porque uma tarefa ficou pronta
+    uint64_t slept_us;          // Tempo total dormindo
+} low_power_stats_t;
+
+#if configUSE_TICKLESS_IDLE == 2
+
+// Reserva o alarme de hardware usado para acordar; chamar antes de iniciar o agendador
+void low_power_init(void);
+
+void low_power_get_stats(low_power_stats_t *stats);
+
+#else
+
+#define low_power_init() ((void)0)
+
+#endif
+
+#endif
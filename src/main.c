@@ -1,329 +1,534 @@
-#include <stdio.h>                   // Inclui a biblioteca padrão de entrada/saída (para printf, etc.)
-#include <stdlib.h>                  // Inclui a biblioteca padrão de utilidades (para rand, etc.)
-#include <string.h>                  // Inclui a biblioteca de manipulação de strings (para memset, snprintf)
-#include "pico/stdlib.h"             // Inclui a biblioteca padrão do SDK do Raspberry Pi Pico
-#include "pico/binary_info.h"        // Inclui a biblioteca para informações binárias do Pico (usado em compilação)
-#include "pico/rand.h"               // Inclui a biblioteca para aquisição de números aleatórios da Raspberry Pi pico
-#include "hardware/gpio.h"           // Inclui a biblioteca para controle de pinos GPIO
-#include "hardware/pwm.h"            // Inclui a biblioteca para controle de PWM (Pulse Width Modulation)
-//#include "hardware/adc.h"            // Inclui a biblioteca para controle do ADC (Analog-to-Digital Converter), embora não seja usado diretamente neste código
-#include "hardware/timer.h"          // Inclui a biblioteca para funções de temporização (usado para get_absolute_time)
-#include "hardware/i2c.h"            // Inclui a biblioteca para comunicação I2C (usado pelo display OLED)
-#include "inc/ssd1306.h"             // Inclui o arquivo de cabeçalho personalizado para o driver do display OLED SSD1306
-#include "FreeRTOS.h"                // Inclui a biblioteca principal do FreeRTOS
-#include "task.h"                    // Inclui a biblioteca para gerenciamento de tarefas do FreeRTOS
-
-// Definições dos pinos GPIO utilizados no projeto
-#define LED_RED_PIN         13       // Pino GPIO para o LED Vermelho
-#define LED_GREEN_PIN       11       // Pino GPIO para o LED Verde
-#define LED_BLUE_PIN        12       // Pino GPIO para o LED Azul
-#define BUZZER_B            10       // Pino GPIO para o Buzzer B
-#define BUZZER_A            21       // Pino GPIO para o Buzzer A
-#define BUTTON_A_PIN        5        // Pino GPIO para o Botão A
-#define BUTTON_B_PIN        6        // Pino GPIO para o Botão B
-#define JOYSTICK_BUTTON     22       // Pino GPIO para o Botão do Joystick (usado para amarelo)
-
-// Definições específicas para a comunicação I2C do display OLED
-#define I2C_SDA             14       // Pino GPIO 14 para dados I2C (SDA)
-#define I2C_SCL             15       // Pino GPIO 15 para clock I2C (SCL)
-
-// Definições das frequências para as notas musicais e duração padrão
-#define NOTE_C4         3000         // Frequência para a nota Dó 4 (arbitrária para o buzzer)
-#define NOTE_D4         3500         // Frequência para a nota Ré 4
-#define NOTE_F4         4000         // Frequência para a nota Fá 4
-#define NOTE_DURATION   300          // Duração padrão das notas em milissegundos (ms)
-
-// Variáveis globais para configuração do PWM dos buzzers
-uint buzzer_slice;                   // Variável para armazenar o 'slice' (bloco de hardware PWM) do buzzer
-uint buzzer_channel;                 // Variável para armazenar o 'canal' (dentro do slice) do buzzer
-
-// Variáveis globais para controlar o estado do jogo
-volatile bool game_over = false;     // Flag booleana que indica se o jogo terminou (volatile para acesso por múltiplas tarefas)
-volatile int countdown_seconds = 60; // Tempo inicial da contagem regressiva em segundos (ajustável), volatile para acesso por múltiplas tarefas
-
-// Protótipos das funções utilizadas no código
-void task_reflex_test(void *params);        // Protótipo da tarefa FreeRTOS para a lógica do jogo de reflexo
-void task_countdown_display(void *params);  // Protótipo da tarefa FreeRTOS para o display OLED e contagem
-void play_tone(uint gpio, uint32_t frequency, uint32_t duration_ms); // Protótipo da função para tocar um tom no buzzer
-void play_color_sound(int color, uint buzzer_pin); // Protótipo da função para tocar o som de acordo com a cor
-void display_two_messages(char *message1, int line1, char *message2, int line2); // Protótipo da função para exibir duas mensagens no OLED
-
-// --- Funções de Inicialização e Controle de Periféricos ---
-
-// Inicializa os pinos GPIO configurando sua direção e, para botões, habilitando pull-ups
-void init_gpio() {
-    gpio_init(LED_RED_PIN);          // Inicializa o pino do LED Vermelho
-    gpio_set_dir(LED_RED_PIN, true); // Define o pino como saída
-
-    gpio_init(LED_GREEN_PIN);        // Inicializa o pino do LED Verde
-    gpio_set_dir(LED_GREEN_PIN, true); // Define o pino como saída
-
-    gpio_init(LED_BLUE_PIN);         // Inicializa o pino do LED Azul
-    gpio_set_dir(LED_BLUE_PIN, true); // Define o pino como saída
-
-    gpio_init(BUZZER_A);             // Inicializa o pino do Buzzer A
-    gpio_set_function(BUZZER_A, GPIO_FUNC_PWM); // Define o pino para função PWM (controle de frequência)
-
-    gpio_init(BUZZER_B);             // Inicializa o pino do Buzzer B
-    gpio_set_function(BUZZER_B, GPIO_FUNC_PWM); // Define o pino para função PWM
-
-    gpio_init(BUTTON_A_PIN);         // Inicializa o pino do Botão A
-    gpio_set_dir(BUTTON_A_PIN, false); // Define o pino como entrada
-    gpio_pull_up(BUTTON_A_PIN);      // Habilita o resistor de pull-up interno (botão conectado ao GND)
-
-    gpio_init(BUTTON_B_PIN);         // Inicializa o pino do Botão B
-    gpio_set_dir(BUTTON_B_PIN, false); // Define o pino como entrada
-    gpio_pull_up(BUTTON_B_PIN);      // Habilita o resistor de pull-up interno
-
-    gpio_init(JOYSTICK_BUTTON);      // Inicializa o pino do Botão do Joystick
-    gpio_set_dir(JOYSTICK_BUTTON, false); // Define o pino como entrada
-    gpio_pull_up(JOYSTICK_BUTTON);   // Habilita o resistor de pull-up interno
-}
-
-// Toca um tom no buzzer especificado com uma dada frequência e duração
-void play_tone(uint gpio, uint32_t frequency, uint32_t duration_ms) {
-    buzzer_slice = pwm_gpio_to_slice_num(gpio);   // Obtém o número do slice PWM associado ao pino GPIO
-    buzzer_channel = pwm_gpio_to_channel(gpio);   // Obtém o número do canal PWM associado ao pino GPIO
-
-    uint32_t clock = 125000000;                   // Frequência do clock do sistema (125 MHz para o Pico)
-    uint32_t wrap = clock / frequency;            // Calcula o valor de 'wrap' (período do PWM) para a frequência desejada
-
-    pwm_config config = pwm_get_default_config(); // Obtém a configuração padrão do PWM
-    pwm_config_set_clkdiv(&config, 1.0f);         // Define o divisor de clock para 1 (sem divisão)
-    pwm_config_set_wrap(&config, wrap);           // Define o valor de 'wrap' (ciclos até reiniciar)
-    pwm_init(buzzer_slice, &config, true);        // Inicializa o slice PWM com a configuração e o habilita
-
-    pwm_set_chan_level(buzzer_slice, buzzer_channel, wrap * 0.3); // Define o nível do canal para 30% do 'wrap' (30% de ciclo de trabalho)
-
-    vTaskDelay(pdMS_TO_TICKS(duration_ms));       // Aguarda a duração especificada da nota usando delay do FreeRTOS
-
-    pwm_set_chan_level(buzzer_slice, buzzer_channel, 0); // Desliga o buzzer definindo o nível do canal para 0
-}
-
-// Toca o som correspondente à cor do LED aceso
-void play_color_sound(int color, uint buzzer_pin) {
-    switch (color) {             // Verifica a cor passada como parâmetro
-        case 0:                  // Se a cor for 0 (verde)
-            play_tone(buzzer_pin, NOTE_C4, NOTE_DURATION); // Toca a nota C4 no buzzer especificado
-            break;               // Sai do switch
-        case 1:                  // Se a cor for 1 (vermelho)
-            play_tone(buzzer_pin, NOTE_D4, NOTE_DURATION); // Toca a nota D4
-            break;               // Sai do switch
-        case 2:                  // Se a cor for 2 (amarelo)
-            play_tone(buzzer_pin, NOTE_F4, NOTE_DURATION); // Toca a nota F4
-            break;               // Sai do switch
-        default:                 // Para qualquer outra cor (caso de segurança)
-            break;               // Não faz nada
-    }
-}
-
-// Função para exibir duas mensagens em linhas diferentes no display OLED
-void display_two_messages(char *message1, int line1, char *message2, int line2) {
-    // Define a área de renderização na tela do OLED (tela inteira)
-    struct render_area frame_area = {
-        .start_column = 0,                       // Coluna inicial (0)
-        .end_column = ssd1306_width - 1,         // Coluna final (largura máxima do display)
-        .start_page = 0,                         // Página inicial (0)
-        .end_page = ssd1306_n_pages - 1          // Página final (número máximo de páginas)
-    };
-    
-    calculate_render_area_buffer_length(&frame_area); // Calcula o tamanho do buffer necessário para a área definida
-
-    uint8_t ssd[ssd1306_buffer_length];             // Declara um array (buffer) para armazenar os dados de pixel
-    memset(ssd, 0, ssd1306_buffer_length);          // Limpa todo o buffer, preenchendo-o com zeros (apaga a tela)
-
-    // Desenha a primeira string no buffer, em X=5 e Y=line1*8 (cada linha de texto tem 8 pixels de altura)
-    ssd1306_draw_string(ssd, 5, line1 * 8, message1); 
-    // Desenha a segunda string no buffer, em X=5 e Y=line2*8
-    ssd1306_draw_string(ssd, 5, line2 * 8, message2); 
-    
-    render_on_display(ssd, &frame_area);            // Envia o conteúdo do buffer para o display OLED, atualizando a tela
-}
-
-// --- Tarefas FreeRTOS ---
-
-// Tarefa para exibir a contagem regressiva e a pontuação no display OLED
-void task_countdown_display(void *params) {
-    // Configuração do barramento I2C para comunicação com o display OLED
-    i2c_init(i2c1, 400000);             // Inicializa o I2C1 a 400kHz (frequência comum para OLED)
-    gpio_set_function(I2C_SDA, GPIO_FUNC_I2C); // Configura o pino SDA (Dados) para a função I2C
-    gpio_set_function(I2C_SCL, GPIO_FUNC_I2C); // Configura o pino SCL (Clock) para a função I2C
-    gpio_pull_up(I2C_SDA);              // Habilita o resistor de pull-up no SDA (necessário para I2C)
-    gpio_pull_up(I2C_SCL);              // Habilita o resistor de pull-up no SCL
-
-    // Inicializa o driver do display OLED
-    ssd1306_init();
-
-    char line1_buffer[32];              // Buffer para armazenar a string da primeira linha (Tempo)
-    char line2_buffer[32];              // Buffer para armazenar a string da segunda linha (Acertos)
-    int *acertos_ptr = (int*)params;    // Ponteiro para a variável global 'game_acertos', que contém a pontuação atual
-
-    // Variável para controlar a contagem de segundos de forma independente da frequência de atualização do display
-    long last_second_tick = xTaskGetTickCount(); // Armazena o "tick" (tempo do FreeRTOS) da última vez que um segundo foi decrementado
-
-    // Loop principal: executa enquanto houver tempo restante no jogo
-    while (countdown_seconds > 0) { 
-        // Formata as strings para exibição no display
-        snprintf(line1_buffer, sizeof(line1_buffer), "Tempo: %02d", countdown_seconds); // Exibe o tempo restante
-        snprintf(line2_buffer, sizeof(line2_buffer), "Acertos: %d", *acertos_ptr);     // Exibe a pontuação atual
-
-        // Envia as mensagens formatadas para o display (atualiza a pontuação rapidamente)
-        display_two_messages(line1_buffer, 2, line2_buffer, 4); // Exibe na linha 2 e 4 do display
-
-        // Atualiza o display mais frequentemente, por exemplo, a cada 100ms
-        vTaskDelay(pdMS_TO_TICKS(100)); // Causa um atraso de 100ms na tarefa (libera CPU para outras tarefas)
-
-        // Verifica se 1 segundo real se passou para decrementar a contagem regressiva
-        if ((xTaskGetTickCount() - last_second_tick) >= pdMS_TO_TICKS(1000)) {
-            countdown_seconds--; // Decrementa o contador de segundos
-            last_second_tick = xTaskGetTickCount(); // Atualiza o último tick para o próximo segundo
-        }
-    }
-
-    // --- O tempo do jogo acabou, agora entra na fase de exibição da tela de "GAME OVER!" ---
-    game_over = true; // Define a flag global 'game_over' para true, sinalizando que o jogo terminou para outras tarefas
-
-    // Loop para manter a mensagem de "GAME OVER!" com a pontuação final na tela por um tempo determinado (5 segundos)
-    for (int i = 0; i < 50; i++) { // Este loop executará 50 vezes
-        snprintf(line1_buffer, sizeof(line1_buffer), "GAME OVER!");    // Primeira linha: "GAME OVER!"
-        snprintf(line2_buffer, sizeof(line2_buffer), "Score: %d", *acertos_ptr); // Segunda linha: "Score: [Pontuação Final]"
-        display_two_messages(line1_buffer, 2, line2_buffer, 4);         // Atualiza o display com a mensagem final
-        vTaskDelay(pdMS_TO_TICKS(100));                                 // Espera 100ms antes de redesenhar (para manter visível)
-    }
-    
-    // Limpa o display completamente após a exibição final
-    display_two_messages("", 0, "", 0); // Envia mensagens vazias para limpar todas as linhas
-
-    // Deleta a própria tarefa, liberando seus recursos na memória do FreeRTOS
-    vTaskDelete(NULL); 
-}
-
-// Tarefa principal que gerencia a lógica do jogo de reflexo
-void task_reflex_test(void *params) {
-    int *acertos_ptr = (int*)params;     // Ponteiro para a variável 'game_acertos' (pontuação)
-    int delay_ms = 1000;                 // Tempo inicial de espera entre os flashes de LEDs (1000 ms = 1 segundo)
-    const int min_delay_ms = 300;        // Tempo mínimo de espera entre os flashes (para não ficar impossível)
-
-    // Loop principal do jogo: continua enquanto a flag 'game_over' for falsa
-    while (!game_over) { 
-        uint32_t color = get_rand_32() % 3;  // Gera um número aleatório (0, 1 ou 2) para escolher a cor (verde, vermelho, amarelo)
-        uint led_pin = 0;                    // Variável para armazenar o pino do LED a ser aceso
-        uint buzzer_pin = 0;                 // Variável para armazenar o pino do buzzer a ser usado
-
-        // Atribui o pino do LED e do buzzer de acordo com a cor escolhida
-        switch (color) {
-            case 0: // Cor 0: Verde
-                led_pin = LED_GREEN_PIN; // Define o LED verde
-                buzzer_pin = BUZZER_A;   // Define o buzzer A
-                break;                   // Sai do switch
-            case 1: // Cor 1: Vermelho
-                led_pin = LED_RED_PIN;   // Define o LED vermelho
-                buzzer_pin = BUZZER_B;   // Define o buzzer B
-                break;                   // Sai do switch
-            case 2: // Cor 2: Amarelo (representado por ambos LED Verde e Vermelho acesos)
-                led_pin = 0;             // Pino não é usado diretamente aqui, os LEDs são controlados em separado
-                buzzer_pin = BUZZER_B;   // Define o buzzer B
-                break;                   // Sai do switch
-        }
-
-        // Acende o(s) LED(s) correspondente(s) à cor escolhida
-        if (color == 2) { // Se a cor for amarelo
-            gpio_put(LED_GREEN_PIN, 1); // Acende o LED verde
-            gpio_put(LED_RED_PIN, 1);   // Acende o LED vermelho
-        } else { // Se for verde ou vermelho
-            gpio_put(led_pin, 1);       // Acende apenas o LED correspondente (verde ou vermelho)
-        }
-
-        play_color_sound(color, buzzer_pin); // Toca o som associado à cor
-
-        bool correct = false; // Flag para indicar se o jogador acertou a cor
-        // Captura o tempo atual para medir o tempo de reação
-        long start_time = to_ms_since_boot(get_absolute_time()); 
-
-        // Loop para esperar o clique do botão correspondente, ou até o tempo limite/game over
-        while (!correct && !game_over) {  
-            // Verifica se o botão A (para verde) foi pressionado
-            if (color == 0 && gpio_get(BUTTON_A_PIN) == 0) { 
-                correct = true; // Acertou
-            } 
-            // Verifica se o botão B (para vermelho) foi pressionado
-            else if (color == 1 && gpio_get(BUTTON_B_PIN) == 0) { 
-                correct = true; // Acertou
-            } 
-            // Verifica se o botão do joystick (para amarelo) foi pressionado
-            else if (color == 2 && gpio_get(JOYSTICK_BUTTON) == 0) { 
-                correct = true; // Acertou
-            }
-            vTaskDelay(pdMS_TO_TICKS(10)); // Pequeno atraso para evitar leituras falsas (debouncing básico) e ceder CPU
-
-            // Verifica se o jogador demorou demais para reagir (tempo limite para o clique)
-            if (to_ms_since_boot(get_absolute_time()) - start_time > delay_ms + 200) { 
-                correct = false; // Não acertou a tempo ou clicou errado
-                break;           // Sai do loop de espera por clique
-            }
-        }
-        
-        // Desliga todos os LEDs após a rodada (clique ou tempo limite)
-        gpio_put(LED_RED_PIN, 0);
-        gpio_put(LED_GREEN_PIN, 0);
-        gpio_put(LED_BLUE_PIN, 0);
-
-        if (correct) {                   // Se o jogador acertou
-            (*acertos_ptr)++;            // Incrementa a pontuação
-            // Se a pontuação for múltipla de 3 e o jogo não estiver no delay mínimo, acelera o jogo
-            if (*acertos_ptr % 3 == 0 && delay_ms > min_delay_ms) {
-                delay_ms -= 100;         // Diminui o tempo de espera em 100ms
-                if (delay_ms < min_delay_ms) { // Garante que o delay não seja menor que o mínimo
-                    delay_ms = min_delay_ms;
-                }
-            }
-        } else {                         // Se o jogador errou ou não clicou a tempo
-            delay_ms += 50;              // Aumenta o tempo de espera (penalidade)
-        }
-        
-        // Se o jogo ainda não acabou, espera o delay atual antes de iniciar a próxima rodada
-        if (!game_over) {
-            vTaskDelay(pdMS_TO_TICKS(delay_ms)); 
-        }
-    }
-    
-    // --- Ao final do jogo (quando 'game_over' se torna true), desliga todos os componentes e encerra a tarefa ---
-    gpio_put(LED_RED_PIN, 0);            // Garante que o LED Vermelho esteja desligado
-    gpio_put(LED_GREEN_PIN, 0);          // Garante que o LED Verde esteja desligado
-    gpio_put(LED_BLUE_PIN, 0);           // Garante que o LED Azul esteja desligado
-    pwm_set_chan_level(buzzer_slice, buzzer_channel, 0); // Garante que o buzzer esteja desligado
-    vTaskDelete(NULL);                   // Deleta a própria tarefa, liberando seus recursos
-}
-
-// --- Função Principal do Programa ---
-int main() {
-    stdio_init_all();                    // Inicializa todas as configurações de I/O padrão (como serial/USB)
-    init_gpio();                         // Chama a função para inicializar todos os pinos GPIO
-
-    // Cria uma variável estática para armazenar a pontuação do jogo.
-    // 'static' garante que esta variável tenha um tempo de vida durante toda a execução do programa
-    // e que seu endereço possa ser passado com segurança para as tarefas.
-    static int game_acertos = 0;         
-
-    // Cria as tarefas do FreeRTOS:
-    // xTaskCreate(Função_da_tarefa, "Nome_da_tarefa", Tamanho_da_pilha, Parâmetro, Prioridade, Handle_da_tarefa);
-    // 1. task_reflex_test: Lógica principal do jogo de reflexo.
-    //    - configMINIMAL_STACK_SIZE + 256: Define o tamanho da pilha da tarefa.
-    //    - (void*)&game_acertos: Passa o endereço da variável 'game_acertos' como parâmetro para a tarefa.
-    //    - 1: Define a prioridade da tarefa (prioridades mais altas executam primeiro).
-    //    - NULL: Não precisamos de um 'handle' para esta tarefa aqui.
-    xTaskCreate(task_reflex_test, "Reflex Test", configMINIMAL_STACK_SIZE + 256, (void*)&game_acertos, 1, NULL);
-    
-    // 2. task_countdown_display: Gerencia o display OLED e a contagem regressiva/pontuação.
-    //    - Também passa o endereço de 'game_acertos' para que possa exibir a pontuação.
-    xTaskCreate(task_countdown_display, "Countdown Display", configMINIMAL_STACK_SIZE + 256, (void*)&game_acertos, 1, NULL);
-
-    vTaskStartScheduler();               // Inicia o agendador do FreeRTOS. A partir daqui, as tarefas criadas começarão a ser executadas.
-
-    // Este loop infinito nunca deve ser alcançado em um sistema FreeRTOS funcionando corretamente,
-    // pois o controle é passado para o agendador de tarefas.
-    while (1) {
-        // O scheduler FreeRTOS irá gerenciar a execução das tarefas criadas.
-    }
-    return 0; // Retorna 0 em caso de encerramento normal (teoricamente nunca alcançado aqui)
-}
+#include <stdio.h>                   // Inclui a biblioteca padrão de entrada/saída (para printf, etc.)
+#include <stdlib.h>                  // Inclui a biblioteca padrão de utilidades (para rand, etc.)
+#include <string.h>                  // Inclui a biblioteca de manipulação de strings (para memset, snprintf)
+#include "pico/stdlib.h"             // Inclui a biblioteca padrão do SDK do Raspberry Pi Pico
+#include "pico/binary_info.h"        // Inclui a biblioteca para informações binárias do Pico (usado em compilação)
+#include "pico/rand.h"               // Inclui a biblioteca para aquisição de números aleatórios da Raspberry Pi pico
+#include "hardware/gpio.h"           // Inclui a biblioteca para controle de pinos GPIO
+#include "hardware/pwm.h"            // Inclui a biblioteca para controle de PWM (Pulse Width Modulation)
+//#include "hardware/adc.h"            // Inclui a biblioteca para controle do ADC (Analog-to-Digital Converter), embora não seja usado diretamente neste código
+#include "hardware/timer.h"          // Inclui a biblioteca para funções de temporização (usado para get_absolute_time)
+#include "hardware/i2c.h"            // Inclui a biblioteca para comunicação I2C (usado pelo display OLED)
+#include "inc/ssd1306.h"             // Inclui o arquivo de cabeçalho personalizado para o driver do display OLED SSD1306
+#include "inc/ssd1306_gfx.h"         // Inclui as primitivas gráficas do framebuffer (limpeza do quadro)
+#include "inc/ssd1306_probe.h"       // Inclui a sonda de velocidade do barramento I2C (REFLEX_I2C_PROBE)
+#include "inc/ssd1306_sprite.h"      // Inclui as imagens 1bpp (e a descompressão das imagens geradas com RLE)
+#include "reflex_assets.h"           // Inclui as imagens do jogo, geradas de assets/ na compilação
+#include "FreeRTOS.h"                // Inclui a biblioteca principal do FreeRTOS
+#include "task.h"                    // Inclui a biblioteca para gerenciamento de tarefas do FreeRTOS
+#include "timers.h"                  // Inclui os timers de software do FreeRTOS (contagem regressiva de 1 Hz)
+#include "input.h"                   // Inclui o módulo de entrada (botões por interrupção, com instante em microssegundos)
+#include "reaction_stats.h"          // Inclui o módulo de estatísticas dos tempos de reação (histograma e percentis)
+#include "game_state.h"              // Inclui o estado compartilhado do jogo (pontuação, tempo e fim de jogo)
+#include "rtos_alloc.h"              // Inclui a criação de tarefas/filas com memória estática ou do heap
+#include "audio.h"                   // Inclui o sequenciador de notas dos buzzers (não bloqueia a tarefa)
+#include "trace.h"                   // Inclui as estatísticas de execução e o rastro de tarefas (REFLEX_TRACE)
+#include "low_power.h"               // Inclui o modo tickless, que dorme entre os eventos (REFLEX_TICKLESS)
+#include "scoreboard.h"              // Inclui o placar opcional no segundo display, no i2c0 (REFLEX_SCOREBOARD)
+#include "reflex_game.h"             // Inclui as regras da partida (cores, janela de resposta e ritmo adaptativo)
+#include "reflex_log.h"              // Inclui a gravação da partida para reprodução no host (REFLEX_RECORD)
+#include "deadline.h"                // Inclui a medição do atraso dos eventos agendados em prazos absolutos
+#include "mem_stats.h"               // Inclui o relatório de uso das pilhas e do heap, com tamanhos recomendados
+
+// Definições dos pinos GPIO utilizados no projeto
+#define LED_RED_PIN         13       // Pino GPIO para o LED Vermelho
+#define LED_GREEN_PIN       11       // Pino GPIO para o LED Verde
+#define LED_BLUE_PIN        12       // Pino GPIO para o LED Azul
+#define BUZZER_B            10       // Pino GPIO para o Buzzer B
+#define BUZZER_A            21       // Pino GPIO para o Buzzer A
+#define BUTTON_A_PIN        5        // Pino GPIO para o Botão A
+#define BUTTON_B_PIN        6        // Pino GPIO para o Botão B
+#define JOYSTICK_BUTTON     22       // Pino GPIO para o Botão do Joystick (usado para amarelo)
+
+// Definições específicas para a comunicação I2C do display OLED
+#define I2C_SDA             14       // Pino GPIO 14 para dados I2C (SDA)
+#define I2C_SCL             15       // Pino GPIO 15 para clock I2C (SCL)
+
+// Definições das frequências para as notas musicais e duração padrão
+#define NOTE_C4         3000         // Frequência para a nota Dó 4 (arbitrária para o buzzer)
+#define NOTE_D4         3500         // Frequência para a nota Ré 4
+#define NOTE_F4         4000         // Frequência para a nota Fá 4
+#define NOTE_DURATION   300          // Duração padrão das notas em milissegundos (ms)
+
+// Retorno do resultado da rodada no outro buzzer (notas MIDI: 96 = dó 7, perto da ressonância do buzzer)
+#define HIT_NOTE_1          96       // Acerto: duas notas subindo (dó 7, sol 7)
+#define HIT_NOTE_2          103
+#define HIT_NOTE_MS         70
+#define MISS_NOTE           72       // Erro ou tempo esgotado: nota grave (dó 5) em onda quadrada
+#define MISS_NOTE_MS        180
+
+// Configuração da partida
+#define GAME_DURATION_S     60       // Tempo inicial da contagem regressiva em segundos (ajustável)
+
+// Núcleos usados no modo SMP (REFLEX_SMP): o display fica isolado no núcleo 1 para que uma
+// transferência I2C nunca atrase a leitura dos botões nem o tempo dos estímulos no núcleo 0
+#define GAME_CORE           0
+#define DISPLAY_CORE        1
+
+// Pilha das tarefas do jogo e do display (em palavras); no perfil estático (REFLEX_STATIC_ALLOC)
+// a memória delas é reservada aqui, em .bss, em vez de vir do heap do FreeRTOS. Os valores podem ser
+// trocados na compilação pelos recomendados nas linhas stack,... do fim da partida (src/mem_stats.h)
+#ifndef GAME_STACK_DEPTH
+#define GAME_STACK_DEPTH    (configMINIMAL_STACK_SIZE + 256)
+#endif
+#ifndef DISPLAY_STACK_DEPTH
+#define DISPLAY_STACK_DEPTH (configMINIMAL_STACK_SIZE + 256)
+#endif
+RTOS_TASK_STORAGE(reflex_task, GAME_STACK_DEPTH);
+RTOS_TASK_STORAGE(display_task, DISPLAY_STACK_DEPTH);
+RTOS_TIMER_STORAGE(countdown);
+
+// Eventos que acordam a tarefa do display (bits da notificação da tarefa)
+#define DISPLAY_EVENT_SCORE   (1 << 0)       // A tarefa do jogo somou um acerto
+#define DISPLAY_EVENT_SECOND  (1 << 1)       // O timer de 1 Hz descontou um segundo
+#define DISPLAY_EVENT_OVER    (1 << 2)       // A contagem chegou a zero
+
+static TaskHandle_t display_task_handle = NULL; // Destino das notificações de mudança de estado
+static TimerHandle_t countdown_timer = NULL;     // Timer de 1 Hz que desconta os segundos da partida
+
+// Prazos da contagem: o timer recarrega a partir do prazo anterior (não do instante em que rodou), então os
+// segundos não acumulam o atraso do callback. Escritos pelo callback e lidos pelo display depois do fim
+static uint64_t countdown_start_us = 0;         // Partida do timer
+static uint64_t countdown_first_us = 0;         // Primeiro segundo (referência dos prazos seguintes)
+static uint64_t countdown_end_us = 0;           // Último segundo (fim da partida)
+static uint32_t countdown_ticks = 0;
+static deadline_stats_t countdown_jitter;
+
+// Estatísticas dos tempos de reação (escritas apenas pela tarefa do jogo)
+static reaction_stats_t reaction_stats;     // Histogramas por cor, de memória fixa
+static reaction_summary_t reaction_summary; // Resumo final, publicado pela tarefa do jogo com GAME_EVENT_SUMMARY_READY
+
+// Protótipos das funções utilizadas no código
+void task_reflex_test(void *params);        // Protótipo da tarefa FreeRTOS para a lógica do jogo de reflexo
+void task_countdown_display(void *params);  // Protótipo da tarefa FreeRTOS para o display OLED e contagem
+void countdown_tick(TimerHandle_t timer);   // Protótipo do callback do timer de 1 Hz da contagem regressiva
+void play_color_sound(int color, uint buzzer_pin); // Protótipo da função para tocar o som de acordo com a cor
+void display_two_messages(char *message1, int line1, char *message2, int line2); // Protótipo da função para exibir duas mensagens no OLED
+void display_stats_screen(int score, const reaction_summary_t *summary); // Protótipo da função para exibir o resumo final no OLED
+
+// --- Funções de Inicialização e Controle de Periféricos ---
+
+// Inicializa os pinos GPIO dos LEDs (os botões são configurados por input_init e os buzzers por audio_init)
+void init_gpio() {
+    gpio_init(LED_RED_PIN);          // Inicializa o pino do LED Vermelho
+    gpio_set_dir(LED_RED_PIN, true); // Define o pino como saída
+
+    gpio_init(LED_GREEN_PIN);        // Inicializa o pino do LED Verde
+    gpio_set_dir(LED_GREEN_PIN, true); // Define o pino como saída
+
+    gpio_init(LED_BLUE_PIN);         // Inicializa o pino do LED Azul
+    gpio_set_dir(LED_BLUE_PIN, true); // Define o pino como saída
+}
+
+// Toca o som correspondente à cor do LED aceso. Só enfileira a nota: o fim dela é tratado pelo
+// timer de software do módulo de áudio, e a tarefa segue imediatamente para a leitura dos botões
+void play_color_sound(int color, uint buzzer_pin) {
+    switch (color) {             // Verifica a cor passada como parâmetro
+        case 0:                  // Se a cor for 0 (verde)
+            audio_play(buzzer_pin, NOTE_C4, NOTE_DURATION); // Toca a nota C4 no buzzer especificado
+            break;               // Sai do switch
+        case 1:                  // Se a cor for 1 (vermelho)
+            audio_play(buzzer_pin, NOTE_D4, NOTE_DURATION); // Toca a nota D4
+            break;               // Sai do switch
+        case 2:                  // Se a cor for 2 (amarelo)
+            audio_play(buzzer_pin, NOTE_F4, NOTE_DURATION); // Toca a nota F4
+            break;               // Sai do switch
+        default:                 // Para qualquer outra cor (caso de segurança)
+            break;               // Não faz nada
+    }
+}
+
+// Toca o retorno da rodada no buzzer que não está com o som da cor, que continua soando por cima
+void play_result_sound(bool correct, uint buzzer_pin) {
+    uint feedback_pin = buzzer_pin == BUZZER_A ? BUZZER_B : BUZZER_A;
+
+    if (correct) {
+        audio_play_note(feedback_pin, &audio_instrument_beep, HIT_NOTE_1, HIT_NOTE_MS);
+        audio_play_note(feedback_pin, &audio_instrument_beep, HIT_NOTE_2, HIT_NOTE_MS);
+    } else {
+        audio_play_note(feedback_pin, &audio_instrument_beep, MISS_NOTE, MISS_NOTE_MS);
+    }
+}
+
+// Função para exibir duas mensagens em linhas diferentes no display OLED
+void display_two_messages(char *message1, int line1, char *message2, int line2) {
+    uint8_t *ssd = ssd1306_back_buffer();           // Quadro de trás do driver (fora da pilha da tarefa)
+    ssd1306_gfx_clear(ssd, ssd1306_width, ssd1306_height, false); // Limpa todo o quadro (apaga a tela)
+
+    // Desenha a primeira string no buffer, em X=5 e Y=line1*8 (cada linha de texto tem 8 pixels de altura)
+    ssd1306_draw_string(ssd, 5, line1 * 8, message1); 
+    // Desenha a segunda string no buffer, em X=5 e Y=line2*8
+    ssd1306_draw_string(ssd, 5, line2 * 8, message2); 
+    
+    // Publica o quadro: o driver envia por DMA só a janela que mudou (na contagem regressiva, normalmente
+    // só os dígitos do tempo) e retorna sem esperar o envio terminar
+    ssd1306_flip();
+}
+
+// Exibe a tela de fim de jogo (assets/game_over.png) com a pontuação embaixo. A imagem ocupa a tela inteira e é
+// descomprimida direto no quadro de trás, sem buffer intermediário
+void display_game_over(int score) {
+    uint8_t *ssd = ssd1306_back_buffer();           // Quadro de trás do driver
+    ssd1306_sprite_t screen;
+    char line[24];
+
+    if (!ssd1306_sprite_unpack(&game_over, ssd, ssd1306_buffer_length, &screen)) {
+        ssd1306_gfx_clear(ssd, ssd1306_width, ssd1306_height, false); // Imagem inválida: só o texto
+    }
+
+    snprintf(line, sizeof(line), "Score: %d", score);
+    ssd1306_draw_string(ssd, (ssd1306_width - (int)strlen(line) * 8) / 2, 52, line); // Centralizada (8 pixels por caractere)
+
+    ssd1306_flip();
+}
+
+// Exibe a tela final com a pontuação e o resumo dos tempos de reação (em ms)
+void display_stats_screen(int score, const reaction_summary_t *summary) {
+    uint8_t *ssd = ssd1306_back_buffer();           // Quadro de trás do driver
+    char line[24];                                  // Texto de cada linha (16 caracteres cabem na largura)
+
+    ssd1306_gfx_clear(ssd, ssd1306_width, ssd1306_height, false);
+
+    ssd1306_draw_string(ssd, 0, 0, "GAME OVER!");
+    snprintf(line, sizeof(line), "Score: %d", score);
+    ssd1306_draw_string(ssd, 0, 8, line);
+    snprintf(line, sizeof(line), "Timeouts: %lu", (unsigned long)summary->timeouts);
+    ssd1306_draw_string(ssd, 0, 16, line);
+    snprintf(line, sizeof(line), "Min: %lu", (unsigned long)(summary->min_us / 1000));
+    ssd1306_draw_string(ssd, 0, 24, line);
+    snprintf(line, sizeof(line), "Media: %lu", (unsigned long)(summary->mean_us / 1000));
+    ssd1306_draw_string(ssd, 0, 32, line);
+    snprintf(line, sizeof(line), "P50: %lu", (unsigned long)(summary->p50_us / 1000));
+    ssd1306_draw_string(ssd, 0, 40, line);
+    snprintf(line, sizeof(line), "P95: %lu", (unsigned long)(summary->p95_us / 1000));
+    ssd1306_draw_string(ssd, 0, 48, line);
+    snprintf(line, sizeof(line), "P99: %lu", (unsigned long)(summary->p99_us / 1000));
+    ssd1306_draw_string(ssd, 0, 56, line);
+
+    ssd1306_flip();
+}
+
+// --- Tarefas FreeRTOS ---
+
+// Callback do timer de 1 Hz (contexto do timer de software): desconta um segundo e avisa o display.
+// No último segundo encerra a partida e para o próprio timer
+void countdown_tick(TimerHandle_t timer) {
+    uint64_t now_us = time_us_64();
+    int seconds_left = game_state_tick_second();
+
+    // Prazos contados do primeiro segundo, para a fase dentro do tick não aparecer como atraso
+    if (countdown_ticks == 0) {
+        countdown_first_us = now_us;
+    } else {
+        deadline_stats_record(&countdown_jitter, countdown_first_us + (uint64_t)countdown_ticks * 1000000, now_us);
+    }
+    countdown_ticks++;
+
+    if (seconds_left > 0) {
+        xTaskNotify(display_task_handle, DISPLAY_EVENT_SECOND, eSetBits);
+        scoreboard_notify();
+        return;
+    }
+
+    countdown_end_us = now_us;
+    xTimerStop(timer, 0);
+    game_state_set_over();               // Sinaliza às outras tarefas que o jogo terminou
+    xTaskNotify(display_task_handle, DISPLAY_EVENT_OVER, eSetBits);
+    scoreboard_notify();
+}
+
+// Tarefa para exibir a contagem regressiva e a pontuação no display OLED.
+// Dorme até uma notificação de mudança (acerto, segundo ou fim de jogo) e só redesenha se o texto mudou
+void task_countdown_display(void *params) {
+    // Configuração do barramento I2C para comunicação com o display OLED
+    i2c_init(i2c1, ssd1306_i2c_clock * 1000); // Inicializa o I2C1 no clock do driver (400kHz por padrão, comum para OLED)
+    gpio_set_function(I2C_SDA, GPIO_FUNC_I2C); // Configura o pino SDA (Dados) para a função I2C
+    gpio_set_function(I2C_SCL, GPIO_FUNC_I2C); // Configura o pino SCL (Clock) para a função I2C
+    gpio_pull_up(I2C_SDA);              // Habilita o resistor de pull-up no SDA (necessário para I2C)
+    gpio_pull_up(I2C_SCL);              // Habilita o resistor de pull-up no SCL
+
+    // Inicializa o driver do display OLED
+    ssd1306_reset_bus_stats();          // Zera os contadores de tráfego do driver
+    ssd1306_init();
+
+#if defined(REFLEX_I2C_PROBE) && REFLEX_I2C_PROBE
+    // Sobe o clock do I2C enquanto os quadros forem aceitos e fica com o mais rápido estável
+    static const uint32_t probe_rates[] = SSD1306_PROBE_DEFAULT_RATES;
+    ssd1306_probe_step_t probe_steps[count_of(probe_rates)];
+    uint32_t probe_hz;
+    int probe_count = ssd1306_probe_bus_speed(ssd1306_get_default(), probe_rates, count_of(probe_rates), probe_steps, &probe_hz);
+    ssd1306_probe_print(probe_steps, probe_count, probe_hz);
+#endif
+
+    ssd1306_bus_stats_t bus_stats;      // Tráfego gasto na inicialização (comandos agrupados em uma só transação)
+    ssd1306_get_bus_stats(&bus_stats);
+    printf("ssd1306_init: %lu transacoes, %lu bytes\n", (unsigned long)bus_stats.transactions, (unsigned long)bus_stats.bytes);
+    ssd1306_reset_bus_stats();          // A partir daqui conta só o tráfego da partida
+    ssd1306_reset_frame_stats();
+
+    char line1_buffer[32];              // Buffer para armazenar a string da primeira linha (Tempo)
+    char line2_buffer[32];              // Buffer para armazenar a string da segunda linha (Acertos)
+    int shown_seconds = -1;             // Valores exibidos no último quadro (-1: nada exibido ainda)
+    int shown_score = -1;
+    uint32_t wakeups = 0;               // Vezes que a tarefa acordou e quadros efetivamente desenhados
+    uint32_t frames = 0;
+    uint32_t events = 0;
+
+    // A contagem regressiva começa quando o display está pronto, como antes
+    deadline_stats_reset(&countdown_jitter);
+    countdown_start_us = time_us_64();
+    xTimerStart(countdown_timer, portMAX_DELAY);
+
+    // Loop principal: redesenha a cada mudança visível até o fim da partida
+    while (!(events & DISPLAY_EVENT_OVER)) {
+        game_state_snapshot_t state;    // Tempo e pontuação da mesma publicação (sem trava)
+        game_state_snapshot(&state);
+        int seconds_left = state.seconds_left;
+        int score = state.score;
+
+        if (seconds_left != shown_seconds || score != shown_score) {
+            // Formata as strings para exibição no display
+            snprintf(line1_buffer, sizeof(line1_buffer), "Tempo: %02d", seconds_left); // Exibe o tempo restante
+            snprintf(line2_buffer, sizeof(line2_buffer), "Acertos: %d", score);        // Exibe a pontuação atual
+            display_two_messages(line1_buffer, 2, line2_buffer, 4); // Exibe na linha 2 e 4 do display
+
+            shown_seconds = seconds_left;
+            shown_score = score;
+            frames++;
+        }
+
+        // Bloqueia sem tempo limite até o próximo evento; eventos simultâneos chegam juntos nos bits
+        xTaskNotifyWait(0, UINT32_MAX, &events, portMAX_DELAY);
+        wakeups++;
+    }
+
+    // --- O tempo do jogo acabou, agora entra na fase de exibição da tela de "GAME OVER!" ---
+    TickType_t game_over_tick = xTaskGetTickCount();
+
+    display_game_over(game_state_score()); // Tela de "GAME OVER" com a pontuação final
+
+    // A tarefa do jogo fecha as estatísticas ao terminar a rodada em andamento; assim que o resumo é
+    // publicado, a tela final passa a mostrá-lo
+    if (game_state_wait(GAME_EVENT_SUMMARY_READY, pdMS_TO_TICKS(5000))) {
+        display_stats_screen(game_state_score(), &reaction_summary);
+    }
+
+    ssd1306_get_bus_stats(&bus_stats);
+    printf("display: %lu despertares, %lu quadros, %lu transacoes, %lu bytes\n", (unsigned long)wakeups,
+           (unsigned long)frames, (unsigned long)bus_stats.transactions, (unsigned long)bus_stats.bytes);
+
+    ssd1306_frame_stats_t frame_stats;  // Intervalo entre quadros e duração dos envios por DMA
+    ssd1306_get_frame_stats(&frame_stats);
+    printf("quadros: %lu enviados, %lu sem mudanca, intervalo min/max %lu/%lu us, envio max %lu us\n",
+           (unsigned long)frame_stats.frames, (unsigned long)frame_stats.unchanged,
+           (unsigned long)frame_stats.min_interval_us, (unsigned long)frame_stats.max_interval_us,
+           (unsigned long)frame_stats.max_transfer_us);
+
+    // Duração real da partida e atraso de cada segundo em relação ao seu prazo
+    printf("partida: %lu us (esperado %lu us)\n", (unsigned long)(countdown_end_us - countdown_start_us),
+           (unsigned long)GAME_DURATION_S * 1000000);
+    deadline_stats_print("contagem", &countdown_jitter);
+
+    // Mantém a tela final por 5 segundos contados do fim da partida
+    vTaskDelayUntil(&game_over_tick, pdMS_TO_TICKS(5000));
+    
+    // Limpa o display completamente após a exibição final
+    display_two_messages("", 0, "", 0); // Envia mensagens vazias para limpar todas as linhas
+    ssd1306_wait_transfer(portMAX_DELAY); // Aguarda o DMA terminar antes de a tarefa deixar de existir
+
+    // Uso de pilha de cada tarefa (com o tamanho recomendado) e do heap, já com a partida inteira medida
+    mem_stats_print();
+
+    // Deleta a própria tarefa, liberando seus recursos na memória do FreeRTOS
+    vTaskDelete(NULL); 
+}
+
+// Tarefa principal que gerencia a lógica do jogo de reflexo
+void task_reflex_test(void *params) {
+    // Regras da partida (src/reflex_game.c): as cores saem de um xorshift32 semeado uma vez pelo gerador do
+    // RP2040, então a semente gravada com REFLEX_RECORD basta para refazer a sequência
+    static const uint buttons[REFLEX_GAME_NUM_COLORS] = {BUTTON_A_PIN, BUTTON_B_PIN, JOYSTICK_BUTTON};
+    static reflex_game_t game;
+    static deadline_stats_t stimulus_jitter; // Atraso de cada estímulo em relação ao prazo da espera
+    uint32_t seed = get_rand_32();
+    uint64_t stimulus_deadline_us = 0;   // Prazo do próximo estímulo (0: primeira rodada, sem prazo)
+
+    reflex_game_init(&game, seed, NOTE_DURATION, buttons);
+    reaction_stats_reset(&reaction_stats); // Começa a partida com os histogramas zerados
+    deadline_stats_reset(&stimulus_jitter);
+    REFLEX_LOG_BEGIN(seed, NOTE_DURATION, buttons, time_us_64()); // Configuração e referência de tempo da partida
+
+    // Loop principal do jogo: continua enquanto o jogo não terminar
+    while (!game_state_is_over()) { 
+        uint color = reflex_game_start_round(&game); // Sorteia a cor (verde, vermelho ou amarelo)
+        uint led_pin = 0;                    // Variável para armazenar o pino do LED a ser aceso
+        uint buzzer_pin = 0;                 // Variável para armazenar o pino do buzzer a ser usado
+
+        // Atribui o pino do LED e do buzzer de acordo com a cor escolhida
+        switch (color) {
+            case 0: // Cor 0: Verde
+                led_pin = LED_GREEN_PIN; // Define o LED verde
+                buzzer_pin = BUZZER_A;   // Define o buzzer A
+                break;                   // Sai do switch
+            case 1: // Cor 1: Vermelho
+                led_pin = LED_RED_PIN;   // Define o LED vermelho
+                buzzer_pin = BUZZER_B;   // Define o buzzer B
+                break;                   // Sai do switch
+            case 2: // Cor 2: Amarelo (representado por ambos LED Verde e Vermelho acesos)
+                led_pin = 0;             // Pino não é usado diretamente aqui, os LEDs são controlados em separado
+                buzzer_pin = BUZZER_B;   // Define o buzzer B
+                break;                   // Sai do switch
+        }
+
+        input_flush();                       // Descarta apertos feitos antes do estímulo
+        uint64_t stimulus_us = time_us_64(); // Instante em que o estímulo aparece (referência do tempo de reação)
+        if (stimulus_deadline_us != 0) {
+            deadline_stats_record(&stimulus_jitter, stimulus_deadline_us, stimulus_us);
+        }
+        REFLEX_LOG(REFLEX_LOG_STIMULUS, stimulus_us, color, game.rounds);
+
+        // Acende o(s) LED(s) correspondente(s) à cor escolhida
+        if (color == 2) { // Se a cor for amarelo
+            gpio_put(LED_GREEN_PIN, 1); // Acende o LED verde
+            gpio_put(LED_RED_PIN, 1);   // Acende o LED vermelho
+        } else { // Se for verde ou vermelho
+            gpio_put(led_pin, 1);       // Acende apenas o LED correspondente (verde ou vermelho)
+        }
+
+        play_color_sound(color, buzzer_pin); // Começa o som associado à cor, sem esperar que ele termine
+
+        bool correct = false; // Flag para indicar se o jogador acertou a cor
+        // Janela de resposta contada desde o estímulo; inclui a duração do som, que antes era esperada
+        // antes de a janela começar, então o tempo total para responder não muda
+        TickType_t window = pdMS_TO_TICKS(reflex_game_window_ms(&game));
+        TickType_t window_start = xTaskGetTickCount();
+        uint64_t window_start_us = time_us_64();
+        input_event_t press;
+
+        // Fim da rodada, de onde a espera até o próximo estímulo é contada: o prazo da janela, se ela estourou,
+        // ou o instante em que o acerto foi tratado
+        TickType_t round_end = window_start + window;
+        uint64_t round_end_us = window_start_us + (uint64_t)reflex_game_window_ms(&game) * 1000;
+
+        // Bloqueia esperando os apertos (sem varredura), até acertar, estourar a janela ou o jogo acabar
+        while (!correct && !game_state_is_over()) {
+            TickType_t elapsed = xTaskGetTickCount() - window_start;
+            if (elapsed >= window || !input_wait(&press, window - elapsed)) {
+                break;           // Tempo limite: o jogador não reagiu a tempo
+            }
+            REFLEX_LOG(REFLEX_LOG_PRESS, press.timestamp_us, press.gpio, 0);
+            if (reflex_game_is_hit(&game, press.gpio)) {
+                correct = true;  // Acertou; botões errados são ignorados, como na versão por varredura
+                round_end = xTaskGetTickCount();
+                round_end_us = time_us_64();
+                reaction_stats_record(&reaction_stats, color, stimulus_us, press.timestamp_us); // Do estímulo até a borda do botão
+            }
+        }
+
+        if (!correct && !game_state_is_over()) {
+            reaction_stats_record_timeout(&reaction_stats, color); // Rodada sem resposta dentro da janela
+        }
+        
+        // Desliga todos os LEDs após a rodada (clique ou tempo limite)
+        gpio_put(LED_RED_PIN, 0);
+        gpio_put(LED_GREEN_PIN, 0);
+        gpio_put(LED_BLUE_PIN, 0);
+
+        if (!game_state_is_over()) {
+            play_result_sound(correct, buzzer_pin); // Só enfileira as notas, como o som da cor
+        }
+
+        if (correct) {                   // Se o jogador acertou
+            game_state_add_point();      // Incrementa a pontuação
+            if (!game_state_is_over()) { // Depois do fim a tela final já mostra a pontuação lida do estado
+                xTaskNotify(display_task_handle, DISPLAY_EVENT_SCORE, eSetBits); // Avisa o display da nova pontuação
+                scoreboard_notify();     // e o placar, se houver
+            }
+        }
+
+        // Acelera a cada 3 acertos (até o mínimo) ou aplica a penalidade por erro ou tempo esgotado
+        int delay_ms = reflex_game_finish_round(&game, correct);
+        REFLEX_LOG(REFLEX_LOG_RESULT, round_end_us, correct, delay_ms); // No instante de onde a espera é contada
+        
+        // Se o jogo ainda não acabou, espera o delay atual contado do fim da rodada (prazo absoluto): o tempo
+        // gasto apagando os LEDs, avisando o display e gravando não alonga a espera
+        if (!game_state_is_over()) {
+            stimulus_deadline_us = round_end_us + (uint64_t)delay_ms * 1000;
+            vTaskDelayUntil(&round_end, pdMS_TO_TICKS(delay_ms));
+        }
+    }
+    
+    REFLEX_LOG(REFLEX_LOG_END, time_us_64(), 0, game_state_score());
+    REFLEX_LOG_DUMP();                   // Com REFLEX_RECORD, envia a partida gravada
+
+    // Fecha as estatísticas da partida: resumo para o display e relatório completo pela USB
+    reaction_summary_t summary;
+    reaction_stats_summary(&reaction_stats, REACTION_STATS_ALL_COLORS, &summary);
+    reaction_summary = summary;          // Publica o resumo para a tarefa do display (o evento vem depois da escrita)
+    game_state_signal(GAME_EVENT_SUMMARY_READY);
+    reaction_stats_print(&reaction_stats);
+    deadline_stats_print("estimulo", &stimulus_jitter);
+
+    // --- Ao final do jogo, desliga todos os componentes e encerra a tarefa ---
+    gpio_put(LED_RED_PIN, 0);            // Garante que o LED Vermelho esteja desligado
+    gpio_put(LED_GREEN_PIN, 0);          // Garante que o LED Verde esteja desligado
+    gpio_put(LED_BLUE_PIN, 0);           // Garante que o LED Azul esteja desligado
+    audio_stop_all();                    // Garante que os buzzers estejam desligados
+    mem_stats_sample_self();             // Guarda o uso de pilha da tarefa para o relatório do display
+    vTaskDelete(NULL);                   // Deleta a própria tarefa, liberando seus recursos
+}
+
+// --- Função Principal do Programa ---
+int main() {
+    stdio_init_all();                    // Inicializa todas as configurações de I/O padrão (como serial/USB)
+    init_gpio();                         // Chama a função para inicializar todos os pinos GPIO
+
+    // Botões com pull-up e interrupção de borda; os apertos chegam à tarefa do jogo por uma fila
+    static const uint buttons[] = {BUTTON_A_PIN, BUTTON_B_PIN, JOYSTICK_BUTTON};
+    input_init(buttons, count_of(buttons));
+
+    // Buzzers no sintetizador (amostras por DMA), cada um com sua fila de notas tocada pelo timer de software
+    // do FreeRTOS; as cores tocam com timbre de sino. As amostras são calculadas no núcleo do display
+    static const uint buzzers[] = {BUZZER_A, BUZZER_B};
+    audio_init(buzzers, count_of(buzzers), 1 << DISPLAY_CORE);
+    audio_set_instrument(BUZZER_A, &audio_instrument_bell);
+    audio_set_instrument(BUZZER_B, &audio_instrument_bell);
+
+    game_state_init(GAME_DURATION_S);    // Pontuação zerada e contagem regressiva cheia
+
+    // Timer de 1 Hz da contagem regressiva (iniciado pela tarefa do display quando a tela está pronta)
+    countdown_timer = RTOS_TIMER_CREATE(countdown, "Countdown", pdMS_TO_TICKS(1000), pdTRUE, NULL, countdown_tick);
+    configASSERT(countdown_timer != NULL);
+
+    // Cria as tarefas do FreeRTOS com rtos_task_create (src/rtos_alloc.h), que usa a memória
+    // declarada acima no perfil estático ou o heap no perfil padrão:
+    // RTOS_TASK_CREATE(Memória, Função_da_tarefa, "Nome_da_tarefa", Tamanho_da_pilha, Parâmetro, Prioridade, Núcleos);
+    // 1. task_reflex_test: Lógica principal do jogo de reflexo.
+    //    - GAME_STACK_DEPTH: Define o tamanho da pilha da tarefa.
+    //    - NULL: O estado compartilhado fica em game_state, não há parâmetro.
+    //    - 1: Define a prioridade da tarefa (prioridades mais altas executam primeiro).
+    //    - Núcleos: máscara de afinidade, usada apenas no SMP.
+    // 2. task_countdown_display: Gerencia o display OLED e a contagem regressiva/pontuação.
+    // No SMP cada tarefa é fixada em um núcleo. A interrupção dos botões foi habilitada acima,
+    // no núcleo 0; a do I2C é habilitada por ssd1306_init, já no núcleo 1
+    RTOS_TASK_CREATE(reflex_task, task_reflex_test, "Reflex Test", GAME_STACK_DEPTH, NULL, 1, 1 << GAME_CORE);
+    display_task_handle = RTOS_TASK_CREATE(display_task, task_countdown_display, "Countdown Display", DISPLAY_STACK_DEPTH, NULL, 1, 1 << DISPLAY_CORE);
+
+    // Com REFLEX_SCOREBOARD, o placar no i2c0 tem sua própria tarefa, no mesmo núcleo do display
+    scoreboard_init(1 << DISPLAY_CORE);
+
+    // Com REFLEX_TRACE, envia o uso de CPU e o rastro pela USB a cada segundo, longe do núcleo do jogo
+    trace_init(1 << DISPLAY_CORE);
+
+    // Com REFLEX_TICKLESS, reserva o alarme que acorda o processador do sono da tarefa ociosa
+    low_power_init();
+
+    vTaskStartScheduler();               // Inicia o agendador do FreeRTOS. A partir daqui, as tarefas criadas começarão a ser executadas.
+
+    // Este loop infinito nunca deve ser alcançado em um sistema FreeRTOS funcionando corretamente,
+    // pois o controle é passado para o agendador de tarefas.
+    while (1) {
+        // O scheduler FreeRTOS irá gerenciar a execução das tarefas criadas.
+    }
+    return 0; // Retorna 0 em caso de encerramento normal (teoricamente nunca alcançado aqui)
+}
@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "mem_stats.h"
+
+#ifndef configTIMER_SERVICE_TASK_NAME
+#define configTIMER_SERVICE_TASK_NAME "Tmr Svc"
+#endif
+
+typedef struct {
+    TaskHandle_t task;
+    const char *name;
+    configSTACK_DEPTH_TYPE depth;
+    UBaseType_t min_free;               // Marca d'água guardada ao encerrar a tarefa
+    bool exited;                        // A tarefa se apagou; o identificador pode ter sido reutilizado
+} mem_stats_task_t;
+
+static mem_stats_task_t mem_stats_tasks[MEM_STATS_MAX_TASKS];
+static UBaseType_t mem_stats_task_count = 0;
+
+void mem_stats_register(TaskHandle_t task, const char *name, configSTACK_DEPTH_TYPE depth) {
+    taskENTER_CRITICAL();
+    if (mem_stats_task_count < MEM_STATS_MAX_TASKS) {
+        mem_stats_task_t *entry = &mem_stats_tasks[mem_stats_task_count++];
+
+        entry->task = task;
+        entry->name = name;
+        entry->depth = depth;
+        entry->min_free = 0;
+        entry->exited = false;
+    }
+    taskEXIT_CRITICAL();
+}
+
+static mem_stats_task_t *mem_stats_find(TaskHandle_t task) {
+    for (UBaseType_t i = 0; i < mem_stats_task_count; i++) {
+        if (!mem_stats_tasks[i].exited && mem_stats_tasks[i].task == task) {
+            return &mem_stats_tasks[i];
+        }
+    }
+    return NULL;
+}
+
+void mem_stats_sample_self(void) {
+    mem_stats_task_t *entry = mem_stats_find(xTaskGetCurrentTaskHandle());
+
+    if (entry != NULL) {
+        entry->min_free = uxTaskGetStackHighWaterMark(NULL);
+        entry->exited = true;
+    }
+}
+
+// Tamanho das pilhas das tarefas do kernel, que não passam por rtos_task_create (0 se desconhecido)
+static configSTACK_DEPTH_TYPE mem_stats_kernel_depth(const char *name) {
+    if (strncmp(name, "IDLE", 4) == 0) {
+        return configMINIMAL_STACK_SIZE;
+    }
+    if (strcmp(name, configTIMER_SERVICE_TASK_NAME) == 0) {
+        return configTIMER_TASK_STACK_DEPTH;
+    }
+    return 0;
+}
+
+static uint32_t mem_stats_round_up(uint32_t value, uint32_t step) {
+    return (value + step - 1) / step * step;
+}
+
+static void mem_stats_print_task(const char *name, configSTACK_DEPTH_TYPE depth, UBaseType_t min_free) {
+    uint32_t used = depth > min_free ? depth - min_free : 0;
+    uint32_t margin = used * MEM_STATS_MARGIN_PERCENT / 100;
+    uint32_t recommended = 0;
+
+    if (depth > 0) {
+        if (margin < MEM_STATS_MARGIN_MIN_WORDS) {
+            margin = MEM_STATS_MARGIN_MIN_WORDS;
+        }
+        recommended = mem_stats_round_up(used + margin, MEM_STATS_ROUND_WORDS);
+    }
+
+    printf("stack,%s,%lu,%lu,%lu,%lu\n", name, (unsigned long)depth, (unsigned long)min_free,
+           (unsigned long)used, (unsigned long)recommended);
+}
+
+void mem_stats_print(void) {
+    static TaskStatus_t status[MEM_STATS_MAX_TASKS + configNUMBER_OF_CORES + 1];
+    UBaseType_t count = uxTaskGetSystemState(status, count_of(status), NULL);
+
+    // Tarefas vivas: marca d'água atual, mantida pelo kernel desde a criação
+    for (UBaseType_t i = 0; i < count; i++) {
+        mem_stats_task_t *entry = mem_stats_find(status[i].xHandle);
+        configSTACK_DEPTH_TYPE depth = entry != NULL ? entry->depth : mem_stats_kernel_depth(status[i].pcTaskName);
+
+        mem_stats_print_task(status[i].pcTaskName, depth, status[i].usStackHighWaterMark);
+    }
+
+    // Tarefas já encerradas: marca d'água guardada por mem_stats_sample_self
+    for (UBaseType_t i = 0; i < mem_stats_task_count; i++) {
+        if (mem_stats_tasks[i].exited) {
+            mem_stats_print_task(mem_stats_tasks[i].name, mem_stats_tasks[i].depth, mem_stats_tasks[i].min_free);
+        }
+    }
+
+#if configSUPPORT_DYNAMIC_ALLOCATION
+    size_t min_free = xPortGetMinimumEverFreeHeapSize();
+    size_t peak = configTOTAL_HEAP_SIZE - min_free;
+
+    uint32_t recommended = mem_stats_round_up(peak + peak * MEM_STATS_MARGIN_PERCENT / 100, MEM_STATS_HEAP_ROUND);
+
+    printf("heap,%lu,%lu,%lu,%lu\n", (unsigned long)configTOTAL_HEAP_SIZE, (unsigned long)xPortGetFreeHeapSize(),
+           (unsigned long)min_free, (unsigned long)recommended);
+#else
+    printf("heap,0,0,0,0\n");           // Perfil estático: não há heap do FreeRTOS
+#endif
+}
+
+// --- Ganchos do kernel (FreeRTOSConfig.h) ---
+
+#if configCHECK_FOR_STACK_OVERFLOW
+// Chamado na troca de contexto quando o fim da pilha da tarefa que sai foi sobrescrito
+void vApplicationStackOverflowHook(TaskHandle_t task, char *name) {
+    panic("pilha estourada: %s", name);
+}
+#endif
+
+#if configUSE_MALLOC_FAILED_HOOK
+void vApplicationMallocFailedHook(void) {
+    panic("heap do FreeRTOS esgotado (%lu bytes livres)", (unsigned long)xPortGetFreeHeapSize());
+}
+#endif
@@ -0,0 +1,31 @@
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifndef mem_stats_inc_h
+#define mem_stats_inc_h
+
+// Uso de memória das tarefas e do heap do FreeRTOS. As tarefas criadas por rtos_task_create são registradas
+// com o tamanho da pilha; o relatório junta a marca d'água de cada uma (menor espaço livre já visto, que o
+// kernel mantém) ao mínimo já livre do heap_4 e sugere o tamanho de cada pilha com uma margem de segurança.
+// Estouros de pilha (configCHECK_FOR_STACK_OVERFLOW 2) e falhas de alocação param o sistema com panic em vez
+// de corromper a memória em silêncio
+
+#define MEM_STATS_MAX_TASKS         12      // Tarefas registradas (as excedentes ficam sem tamanho no relatório)
+#define MEM_STATS_MARGIN_PERCENT    25      // Margem da recomendação sobre o maior uso medido
+#define MEM_STATS_MARGIN_MIN_WORDS  64      // Margem mínima (quadro de exceção e caminhos não exercitados)
+#define MEM_STATS_ROUND_WORDS       16      // Recomendações arredondadas para cima neste múltiplo
+#define MEM_STATS_HEAP_ROUND        1024    // Recomendação do heap arredondada para cima neste múltiplo (bytes)
+
+// Registra uma tarefa e o tamanho da sua pilha (em palavras, como em xTaskCreate)
+void mem_stats_register(TaskHandle_t task, const char *name, configSTACK_DEPTH_TYPE depth);
+
+// Guarda a marca d'água da tarefa atual; chamada antes de vTaskDelete(NULL), pois a tarefa some do relatório
+void mem_stats_sample_self(void);
+
+// Envia pela saída padrão (USB), em palavras da pilha e bytes do heap:
+// stack,<tarefa>,<tamanho>,<livre_min>,<usado_max>,<recomendado>
+// heap,<total>,<livre>,<livre_min>,<recomendado>
+void mem_stats_print(void);
+
+#endif
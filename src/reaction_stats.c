@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "reaction_stats.h"
+
+static const char *reaction_stats_color_names[REACTION_STATS_NUM_COLORS] = {"verde", "vermelho", "amarelo"};
+
+void reaction_stats_reset(reaction_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+    for (int i = 0; i < REACTION_STATS_NUM_COLORS; i++) {
+        stats->color[i].min_us = UINT32_MAX;
+    }
+}
+
+void reaction_stats_record(reaction_stats_t *stats, uint color, uint64_t stimulus_us, uint64_t press_us) {
+    reaction_histogram_t *histogram = &stats->color[color];
+    uint32_t latency_us = press_us > stimulus_us ? (uint32_t)(press_us - stimulus_us) : 0;
+    uint32_t bin = latency_us / REACTION_STATS_BIN_US;
+
+    if (bin >= REACTION_STATS_NUM_BINS) {
+        bin = REACTION_STATS_NUM_BINS - 1;
+    }
+    if (histogram->bins[bin] < UINT16_MAX) {
+        histogram->bins[bin]++;
+    }
+
+    histogram->count++;
+    histogram->sum_us += latency_us;
+    if (latency_us < histogram->min_us) {
+        histogram->min_us = latency_us;
+    }
+    if (latency_us > histogram->max_us) {
+        histogram->max_us = latency_us;
+    }
+}
+
+void reaction_stats_record_timeout(reaction_stats_t *stats, uint color) {
+    stats->color[color].timeouts++;
+}
+
+// Menor tempo tal que pelo menos percent% das respostas das cores first..last foram mais rápidas (limite
+// superior da faixa). As faixas das cores são somadas durante a varredura, sem cópia combinada na pilha
+static uint32_t reaction_stats_percentile(const reaction_stats_t *stats, int first, int last, uint32_t count,
+                                          uint32_t max_us, uint percent) {
+    uint32_t rank = (count * percent + 99) / 100;
+    uint32_t seen = 0;
+
+    if (rank == 0) {
+        rank = 1;
+    }
+    for (uint i = 0; i < REACTION_STATS_NUM_BINS; i++) {
+        for (int c = first; c <= last; c++) {
+            seen += stats->color[c].bins[i];
+        }
+        if (seen >= rank) {
+            uint32_t upper_us = (i + 1) * REACTION_STATS_BIN_US;
+            return upper_us < max_us ? upper_us : max_us;
+        }
+    }
+    return max_us;
+}
+
+void reaction_stats_summary(const reaction_stats_t *stats, int color, reaction_summary_t *summary) {
+    uint32_t max_us = 0;
+    uint64_t sum_us = 0;
+    int first = color < 0 ? 0 : color;
+    int last = color < 0 ? REACTION_STATS_NUM_COLORS - 1 : color;
+
+    memset(summary, 0, sizeof(*summary));
+    summary->min_us = UINT32_MAX;
+
+    for (int c = first; c <= last; c++) {
+        const reaction_histogram_t *histogram = &stats->color[c];
+
+        summary->count += histogram->count;
+        summary->timeouts += histogram->timeouts;
+        sum_us += histogram->sum_us;
+        if (histogram->min_us < summary->min_us) {
+            summary->min_us = histogram->min_us;
+        }
+        if (histogram->max_us > max_us) {
+            max_us = histogram->max_us;
+        }
+    }
+
+    if (summary->count == 0) {
+        summary->min_us = 0;
+        return;
+    }
+
+    summary->mean_us = (uint32_t)(sum_us / summary->count);
+    summary->p50_us = reaction_stats_percentile(stats, first, last, summary->count, max_us, 50);
+    summary->p95_us = reaction_stats_percentile(stats, first, last, summary->count, max_us, 95);
+    summary->p99_us = reaction_stats_percentile(stats, first, last, summary->count, max_us, 99);
+}
+
+void reaction_stats_print(const reaction_stats_t *stats) {
+    reaction_summary_t summary;
+
+    printf("cor,acertos,timeouts,min_us,media_us,p50_us,p95_us,p99_us\n");
+    for (int c = REACTION_STATS_ALL_COLORS; c < REACTION_STATS_NUM_COLORS; c++) {
+        reaction_stats_summary(stats, c, &summary);
+        printf("%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n", c < 0 ? "todas" : reaction_stats_color_names[c],
+               (unsigned long)summary.count, (unsigned long)summary.timeouts, (unsigned long)summary.min_us,
+               (unsigned long)summary.mean_us, (unsigned long)summary.p50_us, (unsigned long)summary.p95_us,
+               (unsigned long)summary.p99_us);
+    }
+
+    // Histograma: apenas as faixas não vazias, com o início da faixa em microssegundos
+    printf("cor,faixa_us,quantidade\n");
+    for (int c = 0; c < REACTION_STATS_NUM_COLORS; c++) {
+        for (uint i = 0; i < REACTION_STATS_NUM_BINS; i++) {
+            if (stats->color[c].bins[i] != 0) {
+                printf("%s,%lu,%u\n", reaction_stats_color_names[c], (unsigned long)(i * REACTION_STATS_BIN_US), stats->color[c].bins[i]);
+            }
+        }
+    }
+}
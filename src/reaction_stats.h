@@ -0,0 +1,51 @@
+#include "pico/stdlib.h"
+
+#ifndef reaction_stats_inc_h
+#define reaction_stats_inc_h
+
+#define REACTION_STATS_NUM_COLORS   3       // Verde, vermelho e amarelo
+#define REACTION_STATS_BIN_US       5000    // Largura de cada faixa do histograma (5 ms)
+#define REACTION_STATS_NUM_BINS     320     // 0..1,6 s; a última faixa acumula os tempos maiores
+
+// Histograma de memória fixa de uma cor; atualizado em O(1), sem alocação
+typedef struct {
+    uint32_t count;
+    uint32_t timeouts;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+    uint16_t bins[REACTION_STATS_NUM_BINS];
+} reaction_histogram_t;
+
+typedef struct {
+    reaction_histogram_t color[REACTION_STATS_NUM_COLORS];
+} reaction_stats_t;
+
+// Resumo de uma cor (ou de todas), em microssegundos; os percentis têm a resolução de uma faixa
+typedef struct {
+    uint32_t count;
+    uint32_t timeouts;
+    uint32_t min_us;
+    uint32_t mean_us;
+    uint32_t p50_us;
+    uint32_t p95_us;
+    uint32_t p99_us;
+} reaction_summary_t;
+
+// Cor usada em reaction_stats_summary para combinar todas as cores
+#define REACTION_STATS_ALL_COLORS   (-1)
+
+void reaction_stats_reset(reaction_stats_t *stats);
+
+// Registra uma rodada respondida: do início do estímulo até a borda do botão
+void reaction_stats_record(reaction_stats_t *stats, uint color, uint64_t stimulus_us, uint64_t press_us);
+
+// Registra uma rodada sem resposta dentro da janela
+void reaction_stats_record_timeout(reaction_stats_t *stats, uint color);
+
+void reaction_stats_summary(const reaction_stats_t *stats, int color, reaction_summary_t *summary);
+
+// Envia o resumo por cor e o histograma (CSV) pela saída padrão (USB)
+void reaction_stats_print(const reaction_stats_t *stats);
+
+#endif
@@ -0,0 +1,57 @@
+#include "pico/stdlib.h"
+#include "reflex_game.h"
+
+void reflex_game_init(reflex_game_t *game, uint32_t seed, uint note_ms, const uint buttons[REFLEX_GAME_NUM_COLORS]) {
+    game->rng = seed != 0 ? seed : 1;
+    game->note_ms = note_ms;
+    for (int i = 0; i < REFLEX_GAME_NUM_COLORS; i++) {
+        game->buttons[i] = buttons[i];
+    }
+    game->delay_ms = REFLEX_GAME_INITIAL_DELAY;
+    game->hits = 0;
+    game->rounds = 0;
+    game->color = 0;
+}
+
+// xorshift32: a mesma semente sempre gera a mesma sequência de cores
+static uint32_t reflex_game_random(reflex_game_t *game) {
+    uint32_t x = game->rng;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    game->rng = x;
+    return x;
+}
+
+uint reflex_game_start_round(reflex_game_t *game) {
+    game->color = reflex_game_random(game) % REFLEX_GAME_NUM_COLORS;
+    game->rounds++;
+    return game->color;
+}
+
+uint reflex_game_window_ms(const reflex_game_t *game) {
+    return game->note_ms + game->delay_ms + REFLEX_GAME_WINDOW_EXTRA_MS;
+}
+
+bool reflex_game_is_hit(const reflex_game_t *game, uint gpio) {
+    return gpio == game->buttons[game->color];
+}
+
+int reflex_game_finish_round(reflex_game_t *game, bool hit) {
+    if (hit) {
+        game->hits++;
+        // A cada REFLEX_GAME_SPEEDUP_HITS acertos, se ainda não está no mínimo, acelera o jogo
+        if (game->hits % REFLEX_GAME_SPEEDUP_HITS == 0 && game->delay_ms > REFLEX_GAME_MIN_DELAY) {
+            game->delay_ms -= REFLEX_GAME_SPEEDUP_MS;
+            if (game->delay_ms < REFLEX_GAME_MIN_DELAY) {
+                game->delay_ms = REFLEX_GAME_MIN_DELAY;
+            }
+        }
+    }
+    else {
+        game->delay_ms += REFLEX_GAME_PENALTY_MS; // Penalidade por erro ou tempo esgotado
+    }
+
+    return game->delay_ms;
+}
@@ -0,0 +1,44 @@
+#include "pico/stdlib.h"
+
+#ifndef reflex_game_inc_h
+#define reflex_game_inc_h
+
+// Regras de uma partida, sem dependência do FreeRTOS nem do hardware: sorteio das cores (xorshift32 a
+// partir de uma semente), janela de resposta, botão esperado e o ritmo adaptativo (acelera a cada 3 acertos,
+// desacelera 50 ms a cada erro). A tarefa do jogo e o reprodutor de partidas gravadas (host/reflex_replay.c)
+// usam as mesmas funções, de modo que uma partida gravada pode ser refeita fora do tempo real
+
+#define REFLEX_GAME_NUM_COLORS      3       // Verde, vermelho e amarelo
+#define REFLEX_GAME_INITIAL_DELAY   1000    // Espera inicial entre as rodadas (ms)
+#define REFLEX_GAME_MIN_DELAY       300     // Espera mínima entre as rodadas (ms)
+#define REFLEX_GAME_SPEEDUP_HITS    3       // Acertos entre duas acelerações
+#define REFLEX_GAME_SPEEDUP_MS      100     // Redução da espera a cada aceleração
+#define REFLEX_GAME_PENALTY_MS      50      // Aumento da espera a cada erro
+#define REFLEX_GAME_WINDOW_EXTRA_MS 200     // Folga da janela de resposta além do som e da espera
+
+typedef struct {
+    uint32_t rng;                           // Estado do xorshift32 (nunca zero)
+    uint note_ms;                           // Duração do som do estímulo
+    uint buttons[REFLEX_GAME_NUM_COLORS];   // Botão esperado para cada cor
+    int delay_ms;                           // Espera atual entre as rodadas
+    int hits;
+    int rounds;
+    uint color;                             // Cor da rodada em andamento
+} reflex_game_t;
+
+// Começa uma partida com a semente indicada (zero vira 1)
+void reflex_game_init(reflex_game_t *game, uint32_t seed, uint note_ms, const uint buttons[REFLEX_GAME_NUM_COLORS]);
+
+// Sorteia a cor da próxima rodada (0 verde, 1 vermelho, 2 amarelo)
+uint reflex_game_start_round(reflex_game_t *game);
+
+// Janela de resposta da rodada, contada desde o estímulo
+uint reflex_game_window_ms(const reflex_game_t *game);
+
+// Verdadeiro se o botão é o esperado para a cor da rodada (os outros são ignorados)
+bool reflex_game_is_hit(const reflex_game_t *game, uint gpio);
+
+// Fecha a rodada e retorna a espera até a próxima, já ajustada pelo ritmo adaptativo
+int reflex_game_finish_round(reflex_game_t *game, bool hit);
+
+#endif
@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "reflex_game.h"
+#include "reflex_log.h"
+
+#if defined(REFLEX_RECORD) && REFLEX_RECORD
+
+// Só a tarefa do jogo grava (as bordas dos botões chegam a ela pela fila de input), então não há trava
+static reflex_log_record_t reflex_log_records[REFLEX_LOG_MAX_RECORDS];
+static uint32_t reflex_log_count = 0;
+static uint32_t reflex_log_dropped = 0;
+static uint32_t reflex_log_seed = 0;
+static uint16_t reflex_log_note_ms = 0;
+static uint8_t reflex_log_buttons[REFLEX_GAME_NUM_COLORS];
+static uint64_t reflex_log_start_us = 0;
+
+_Static_assert(REFLEX_GAME_NUM_COLORS == 3, "o cabeçalho do registro tem um byte de botão por cor");
+
+void reflex_log_begin(uint32_t seed, uint note_ms, const uint *buttons, uint64_t start_us) {
+    reflex_log_seed = seed;
+    reflex_log_note_ms = (uint16_t)note_ms;
+    for (int i = 0; i < REFLEX_GAME_NUM_COLORS; i++) {
+        reflex_log_buttons[i] = (uint8_t)buttons[i];
+    }
+    reflex_log_start_us = start_us;
+    reflex_log_count = 0;
+    reflex_log_dropped = 0;
+}
+
+void reflex_log_add(uint8_t type, uint64_t time_us, uint8_t arg0, uint16_t arg1) {
+    if (reflex_log_count >= REFLEX_LOG_MAX_RECORDS) {
+        reflex_log_dropped++;
+        return;
+    }
+
+    reflex_log_record_t *record = &reflex_log_records[reflex_log_count++];
+
+    record->time_us = time_us > reflex_log_start_us ? (uint32_t)(time_us - reflex_log_start_us) : 0;
+    record->type = type;
+    record->arg0 = arg0;
+    record->arg1 = arg1;
+}
+
+static void reflex_log_put_u32(uint8_t *bytes, uint32_t value) {
+    bytes[0] = (uint8_t)value;
+    bytes[1] = (uint8_t)(value >> 8);
+    bytes[2] = (uint8_t)(value >> 16);
+    bytes[3] = (uint8_t)(value >> 24);
+}
+
+#if defined(REFLEX_HOST_BUILD) && REFLEX_HOST_BUILD
+
+// No host o quadro vai para o arquivo de REFLEX_RECORD (ou para a saída padrão, se não houver)
+static void reflex_log_write(const uint8_t *bytes, size_t length) {
+    static FILE *file = NULL;
+
+    if (file == NULL) {
+        const char *path = getenv("REFLEX_RECORD");
+
+        file = path != NULL ? fopen(path, "wb") : NULL;
+        if (file == NULL) {
+            file = stdout;
+        }
+    }
+    fwrite(bytes, 1, length, file);
+}
+
+#else
+
+// putchar_raw: sem conversão de fim de linha, como os quadros do rastro
+static void reflex_log_write(const uint8_t *bytes, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        putchar_raw(bytes[i]);
+    }
+}
+
+#endif
+
+void reflex_log_dump(void) {
+    uint8_t header[REFLEX_LOG_HEADER_SIZE] = {0};
+
+    memcpy(header, REFLEX_LOG_MAGIC, 4);
+    header[4] = REFLEX_LOG_VERSION;
+    memcpy(&header[5], reflex_log_buttons, REFLEX_GAME_NUM_COLORS);
+    reflex_log_put_u32(&header[8], reflex_log_seed);
+    reflex_log_put_u32(&header[12], reflex_log_count);
+    header[16] = (uint8_t)reflex_log_note_ms;
+    header[17] = (uint8_t)(reflex_log_note_ms >> 8);
+
+    if (reflex_log_dropped > 0) {
+        printf("reflex_log,dropped,%lu\n", (unsigned long)reflex_log_dropped);
+    }
+
+    reflex_log_write(header, sizeof(header));
+    for (uint32_t i = 0; i < reflex_log_count; i++) {
+        uint8_t bytes[sizeof(reflex_log_record_t)];
+        const reflex_log_record_t *record = &reflex_log_records[i];
+
+        reflex_log_put_u32(bytes, record->time_us);
+        bytes[4] = record->type;
+        bytes[5] = record->arg0;
+        bytes[6] = (uint8_t)record->arg1;
+        bytes[7] = (uint8_t)(record->arg1 >> 8);
+        reflex_log_write(bytes, sizeof(bytes));
+    }
+    fflush(NULL);                        // Saída padrão e, no host, o arquivo do registro
+}
+
+#endif
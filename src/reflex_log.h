@@ -0,0 +1,59 @@
+#include "pico/stdlib.h"
+
+#ifndef reflex_log_inc_h
+#define reflex_log_inc_h
+
+// Gravação da partida para reprodução determinística (cmake -DREFLEX_RECORD=ON).
+// Guarda a semente das cores, cada estímulo, as bordas dos botões entregues ao jogo e o resultado de cada
+// rodada em registros binários de 8 bytes, sem texto e sem alocação. No fim da partida o registro é enviado
+// pela saída padrão (USB) como um quadro binário; no host vai para o arquivo indicado em REFLEX_RECORD.
+// host/reflex_replay.c refaz a partida com as mesmas regras (src/reflex_game.c) mais rápido que o tempo real
+
+#define REFLEX_LOG_MAX_RECORDS  1024    // Registros guardados (os excedentes são contados em dropped)
+#define REFLEX_LOG_VERSION      2
+
+// Cabeçalho do quadro (20 bytes, little-endian): "RXLG", versão, o GPIO do botão de cada uma das 3 cores,
+// semente, quantidade de registros, duração do som do estímulo (ms, 16 bits) e 2 bytes reservados. Os botões
+// e a duração vão junto para que a reprodução use a configuração da partida gravada. Os registros vêm em seguida
+#define REFLEX_LOG_MAGIC        "RXLG"
+#define REFLEX_LOG_HEADER_SIZE  20
+
+// Tipos de registro
+#define REFLEX_LOG_STIMULUS     1       // arg0 = cor, arg1 = número da rodada
+#define REFLEX_LOG_PRESS        2       // arg0 = GPIO do botão (instante da borda, medido na interrupção)
+#define REFLEX_LOG_RESULT       3       // Fim da rodada; arg0 = 1 se acertou, arg1 = espera até a próxima (ms)
+#define REFLEX_LOG_END          4       // arg1 = pontuação final
+
+// Registro (8 bytes): instante em µs desde o início da partida, tipo e argumentos
+typedef struct {
+    uint32_t time_us;
+    uint8_t type;
+    uint8_t arg0;
+    uint16_t arg1;
+} reflex_log_record_t;
+
+#if defined(REFLEX_RECORD) && REFLEX_RECORD
+
+// Começa a gravação com a configuração da partida (a mesma passada a reflex_game_init); start_us é o
+// instante de referência dos registros
+void reflex_log_begin(uint32_t seed, uint note_ms, const uint *buttons, uint64_t start_us);
+
+// Acrescenta um registro no instante time_us (mesma base de tempo de start_us)
+void reflex_log_add(uint8_t type, uint64_t time_us, uint8_t arg0, uint16_t arg1);
+
+// Envia o quadro com o cabeçalho e os registros
+void reflex_log_dump(void);
+
+#define REFLEX_LOG_BEGIN(seed, note_ms, buttons, start_us) reflex_log_begin(seed, note_ms, buttons, start_us)
+#define REFLEX_LOG(type, time_us, arg0, arg1) reflex_log_add(type, time_us, arg0, arg1)
+#define REFLEX_LOG_DUMP() reflex_log_dump()
+
+#else
+
+#define REFLEX_LOG_BEGIN(seed, note_ms, buttons, start_us) ((void)0)
+#define REFLEX_LOG(type, time_us, arg0, arg1) ((void)0)
+#define REFLEX_LOG_DUMP() ((void)0)
+
+#endif
+
+#endif
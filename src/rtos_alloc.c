@@ -0,0 +1,68 @@
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "rtos_alloc.h"
+#include "mem_stats.h"
+
+TaskHandle_t rtos_task_create(TaskFunction_t fn, const char *name, configSTACK_DEPTH_TYPE depth, void *param,
+                              UBaseType_t priority, UBaseType_t core_mask, StackType_t *stack, StaticTask_t *tcb) {
+    TaskHandle_t handle = NULL;
+
+#if configSUPPORT_STATIC_ALLOCATION
+#if configNUMBER_OF_CORES > 1
+    handle = xTaskCreateStaticAffinitySet(fn, name, depth, param, priority, stack, tcb, core_mask);
+#else
+    (void)core_mask;
+    handle = xTaskCreateStatic(fn, name, depth, param, priority, stack, tcb);
+#endif
+#else
+    (void)stack;
+    (void)tcb;
+#if configNUMBER_OF_CORES > 1
+    xTaskCreateAffinitySet(fn, name, depth, param, priority, core_mask, &handle);
+#else
+    (void)core_mask;
+    xTaskCreate(fn, name, depth, param, priority, &handle);
+#endif
+#endif
+
+    configASSERT(handle != NULL);
+    mem_stats_register(handle, name, depth); // Tamanho da pilha para o relatório de memória
+    return handle;
+}
+
+#if configSUPPORT_STATIC_ALLOCATION
+
+// Memória das tarefas internas do kernel (ociosa e de timers), pedida pelo FreeRTOS no perfil estático
+
+void vApplicationGetIdleTaskMemory(StaticTask_t **tcb, StackType_t **stack, configSTACK_DEPTH_TYPE *depth) {
+    static StaticTask_t idle_tcb;
+    static StackType_t idle_stack[configMINIMAL_STACK_SIZE];
+
+    *tcb = &idle_tcb;
+    *stack = idle_stack;
+    *depth = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t **tcb, StackType_t **stack, configSTACK_DEPTH_TYPE *depth) {
+    static StaticTask_t timer_tcb;
+    static StackType_t timer_stack[configTIMER_TASK_STACK_DEPTH];
+
+    *tcb = &timer_tcb;
+    *stack = timer_stack;
+    *depth = configTIMER_TASK_STACK_DEPTH;
+}
+
+#if configNUMBER_OF_CORES > 1
+// No SMP há uma tarefa ociosa "passiva" para cada núcleo além do primeiro
+void vApplicationGetPassiveIdleTaskMemory(StaticTask_t **tcb, StackType_t **stack, configSTACK_DEPTH_TYPE *depth, BaseType_t index) {
+    static StaticTask_t passive_idle_tcb[configNUMBER_OF_CORES - 1];
+    static StackType_t passive_idle_stack[configNUMBER_OF_CORES - 1][configMINIMAL_STACK_SIZE];
+
+    *tcb = &passive_idle_tcb[index];
+    *stack = passive_idle_stack[index];
+    *depth = configMINIMAL_STACK_SIZE;
+}
+#endif
+
+#endif
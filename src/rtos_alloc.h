@@ -0,0 +1,71 @@
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+#include "event_groups.h"
+
+#ifndef rtos_alloc_inc_h
+#define rtos_alloc_inc_h
+
+// Criação dos objetos do FreeRTOS (tarefas, filas, timers e grupos de eventos) independente do perfil de memória.
+// Com REFLEX_STATIC_ALLOC (configSUPPORT_STATIC_ALLOCATION) a memória de cada objeto é declarada
+// estaticamente com os macros *_STORAGE e não existe heap do FreeRTOS; sem ela, os macros *_STORAGE
+// não reservam nada e os objetos vêm do heap_4.
+//
+// Uso (em escopo de arquivo):  RTOS_TASK_STORAGE(display, DISPLAY_STACK_DEPTH);
+// e depois:                    RTOS_TASK_CREATE(display, task_fn, "Display", DISPLAY_STACK_DEPTH, NULL, 1, core_mask);
+
+#if configSUPPORT_STATIC_ALLOCATION
+
+#define RTOS_TASK_STORAGE(name, depth) \
+    static StackType_t name##_stack[depth]; \
+    static StaticTask_t name##_tcb
+#define RTOS_TASK_CREATE(name, fn, label, depth, param, priority, core_mask) \
+    rtos_task_create(fn, label, depth, param, priority, core_mask, name##_stack, &name##_tcb)
+
+#define RTOS_QUEUE_STORAGE(name, length, item_size) \
+    static uint8_t name##_queue_items[(length) * (item_size)]; \
+    static StaticQueue_t name##_queue_buffer
+#define RTOS_QUEUE_CREATE(name, length, item_size) \
+    xQueueCreateStatic(length, item_size, name##_queue_items, &name##_queue_buffer)
+
+#define RTOS_TIMER_STORAGE(name) \
+    static StaticTimer_t name##_timer_buffer
+#define RTOS_TIMER_CREATE(name, label, period, auto_reload, id, callback) \
+    xTimerCreateStatic(label, period, auto_reload, id, callback, &name##_timer_buffer)
+
+#define RTOS_EVENT_GROUP_STORAGE(name) \
+    static StaticEventGroup_t name##_event_group_buffer
+#define RTOS_EVENT_GROUP_CREATE(name) \
+    xEventGroupCreateStatic(&name##_event_group_buffer)
+
+#else
+
+#define RTOS_TASK_STORAGE(name, depth) struct name##_task_storage
+#define RTOS_TASK_CREATE(name, fn, label, depth, param, priority, core_mask) \
+    rtos_task_create(fn, label, depth, param, priority, core_mask, NULL, NULL)
+
+#define RTOS_QUEUE_STORAGE(name, length, item_size) struct name##_queue_storage
+#define RTOS_QUEUE_CREATE(name, length, item_size) \
+    xQueueCreate(length, item_size)
+
+#define RTOS_TIMER_STORAGE(name) struct name##_timer_storage
+#define RTOS_TIMER_CREATE(name, label, period, auto_reload, id, callback) \
+    xTimerCreate(label, period, auto_reload, id, callback)
+
+#define RTOS_EVENT_GROUP_STORAGE(name) struct name##_event_group_storage
+#define RTOS_EVENT_GROUP_CREATE(name) \
+    xEventGroupCreate()
+
+#endif
+
+// Máscara de afinidade que permite qualquer núcleo
+#define RTOS_ANY_CORE ((UBaseType_t)-1)
+
+// Cria a tarefa com a memória fornecida (perfil estático) ou do heap, fixada em core_mask no SMP.
+// Falha na criação é erro de configuração e para no configASSERT. A tarefa é registrada em mem_stats
+TaskHandle_t rtos_task_create(TaskFunction_t fn, const char *name, configSTACK_DEPTH_TYPE depth, void *param,
+                              UBaseType_t priority, UBaseType_t core_mask, StackType_t *stack, StaticTask_t *tcb);
+
+#endif
@@ -0,0 +1,91 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "hardware/i2c.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "inc/ssd1306.h"
+#include "inc/ssd1306_gfx.h"
+#include "game_state.h"
+#include "rtos_alloc.h"
+#include "mem_stats.h"
+#include "scoreboard.h"
+
+#if defined(REFLEX_SCOREBOARD) && REFLEX_SCOREBOARD
+
+#ifndef SCOREBOARD_STACK_DEPTH
+#define SCOREBOARD_STACK_DEPTH  (configMINIMAL_STACK_SIZE + 128)
+#endif
+
+RTOS_TASK_STORAGE(scoreboard_task, SCOREBOARD_STACK_DEPTH);
+SSD1306_STORAGE(scoreboard, SCOREBOARD_WIDTH, SCOREBOARD_HEIGHT);
+
+static ssd1306_t scoreboard_display;
+static TaskHandle_t scoreboard_task_handle = NULL;
+
+// Redesenha o placar no buffer de trás da instância e publica o quadro (só a janela que mudou é enviada)
+static void scoreboard_draw(int score, int seconds_left, bool over) {
+    uint8_t *frame = ssd1306_display_back_buffer(&scoreboard_display);
+    int width = scoreboard_display.width;   // Geometria da instância, não a do display do jogo
+    int height = scoreboard_display.height;
+    char line[24];
+
+    ssd1306_gfx_clear(frame, width, height, false);
+    ssd1306_frame_draw_string(frame, width, height, 0, 0, over ? "FIM DE JOGO" : "PLACAR");
+    ssd1306_gfx_hspan(frame, width, height, 0, 10, width, SSD1306_GFX_SET);
+    snprintf(line, sizeof(line), "Acertos: %d", score);
+    ssd1306_frame_draw_string(frame, width, height, 0, 24, line);
+    if (!over) {
+        snprintf(line, sizeof(line), "Tempo: %02d", seconds_left);
+        ssd1306_frame_draw_string(frame, width, height, 0, 40, line);
+    }
+
+    ssd1306_display_flip(&scoreboard_display);
+}
+
+static void task_scoreboard(void *params) {
+    i2c_init(i2c0, ssd1306_i2c_clock * 1000);
+    gpio_set_function(SCOREBOARD_SDA, GPIO_FUNC_I2C);
+    gpio_set_function(SCOREBOARD_SCL, GPIO_FUNC_I2C);
+    gpio_pull_up(SCOREBOARD_SDA);
+    gpio_pull_up(SCOREBOARD_SCL);
+
+    SSD1306_INIT_DISPLAY(&scoreboard_display, scoreboard, SCOREBOARD_WIDTH, SCOREBOARD_HEIGHT, false, SCOREBOARD_ADDRESS, i2c0);
+    ssd1306_config(&scoreboard_display);
+
+    bool over = false;
+    while (!over) {
+        game_state_snapshot_t state;    // Pontuação, tempo e fim de jogo coerentes entre si
+        game_state_snapshot(&state);
+        over = state.over;
+        scoreboard_draw(state.score, state.seconds_left, over);
+
+        if (!over) {
+            // Avisos que chegam durante o desenho acumulam no contador e geram um único redesenho
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+    }
+
+    ssd1306_display_wait(&scoreboard_display, portMAX_DELAY);
+
+    ssd1306_frame_stats_t frame_stats;
+    ssd1306_display_get_frame_stats(&scoreboard_display, &frame_stats);
+    printf("placar: %lu quadros, envio max %lu us\n", (unsigned long)frame_stats.frames,
+           (unsigned long)frame_stats.max_transfer_us);
+
+    mem_stats_sample_self();
+    vTaskDelete(NULL);
+}
+
+void scoreboard_init(UBaseType_t core_mask) {
+    scoreboard_task_handle = RTOS_TASK_CREATE(scoreboard_task, task_scoreboard, "Scoreboard", SCOREBOARD_STACK_DEPTH,
+                                              NULL, 1, core_mask);
+}
+
+void scoreboard_notify(void) {
+    if (scoreboard_task_handle != NULL) {
+        xTaskNotifyGive(scoreboard_task_handle);
+    }
+}
+
+#endif
@@ -0,0 +1,32 @@
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+
+#ifndef scoreboard_inc_h
+#define scoreboard_inc_h
+
+// Placar opcional em um segundo SSD1306 no i2c0 (cmake -DREFLEX_SCOREBOARD=ON). Tem sua própria
+// instância do driver e sua própria tarefa: os quadros dele saem pelo canal DMA do i2c0 ao mesmo
+// tempo que os do display do jogo saem pelo i2c1, sem que um envio espere pelo outro
+
+#define SCOREBOARD_SDA          0       // Pino GPIO 0 para dados I2C (SDA) do i2c0
+#define SCOREBOARD_SCL          1       // Pino GPIO 1 para clock I2C (SCL) do i2c0
+#define SCOREBOARD_ADDRESS      0x3C    // Endereço do segundo display (no próprio barramento)
+#define SCOREBOARD_WIDTH        128
+#define SCOREBOARD_HEIGHT       64
+
+#if defined(REFLEX_SCOREBOARD) && REFLEX_SCOREBOARD
+
+// Cria a tarefa do placar (fixada em core_mask no SMP)
+void scoreboard_init(UBaseType_t core_mask);
+
+// Avisa o placar de que a pontuação, o tempo ou a fase da partida mudou (contexto de tarefa)
+void scoreboard_notify(void);
+
+#else
+
+#define scoreboard_init(core_mask) ((void)(core_mask))
+#define scoreboard_notify() ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/timer.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "trace.h"
+#include "rtos_alloc.h"
+
+#if defined(REFLEX_TRACE) && REFLEX_TRACE
+
+#if configNUMBER_OF_CORES > 1
+#define TRACE_CORE_ID() ((uint)portGET_CORE_ID())
+#else
+#define TRACE_CORE_ID() 0U
+#endif
+
+#ifndef TRACE_STACK_DEPTH
+#define TRACE_STACK_DEPTH (configMINIMAL_STACK_SIZE + 256)
+#endif
+
+// Anel de um núcleo: só o próprio núcleo escreve (com as interrupções mascaradas), então não há trava.
+// head conta todos os registros já escritos; o leitor detecta sobrescrita pela distância até head
+typedef struct {
+    trace_record_t records[TRACE_RING_LENGTH];
+    uint32_t head;
+} trace_ring_t;
+
+static trace_ring_t trace_rings[configNUMBER_OF_CORES];
+
+// Tarefas numeradas na primeira vez em que entram em execução (0 = ainda sem número)
+static TaskHandle_t trace_tasks[TRACE_MAX_TASKS];
+static uint32_t trace_switches[TRACE_MAX_TASKS];
+static UBaseType_t trace_task_count = 0;
+
+RTOS_TASK_STORAGE(trace_stream, TRACE_STACK_DEPTH);
+
+uint64_t trace_run_time_us(void) {
+    return time_us_64();
+}
+
+static void trace_write(uint8_t type, uint8_t id) {
+    UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    uint core = TRACE_CORE_ID();
+    trace_ring_t *ring = &trace_rings[core];
+    uint32_t head = ring->head;
+    trace_record_t *record = &ring->records[head % TRACE_RING_LENGTH];
+
+    record->timestamp_us = (uint32_t)time_us_64();
+    record->type = type;
+    record->id = id;
+    record->core = core;
+    record->reserved = 0;
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE); // Publica o registro completo
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+void trace_isr_enter(uint8_t irq) {
+    trace_write(TRACE_EVENT_ISR, irq);
+}
+
+// Chamado pelo kernel em traceTASK_SWITCHED_IN, dentro da troca de contexto (o kernel já serializa as chamadas)
+void trace_task_switched_in(void) {
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    UBaseType_t number = uxTaskGetTaskNumber(task);
+
+    if (number == 0) {
+        number = trace_task_count < TRACE_MAX_TASKS - 1 ? ++trace_task_count : TRACE_MAX_TASKS - 1;
+        trace_tasks[number] = task;
+        vTaskSetTaskNumber(task, number);
+    }
+
+    trace_switches[number]++;
+    trace_write(TRACE_EVENT_SWITCH, (uint8_t)number);
+}
+
+// Uso de CPU de cada tarefa no último intervalo, em décimos de ponto percentual, e trocas acumuladas:
+// cpu,<número>,<nome>,<permil>,<trocas>
+static void trace_print_stats(void) {
+    static TaskStatus_t status[TRACE_MAX_TASKS];
+    static configRUN_TIME_COUNTER_TYPE last_run_time[TRACE_MAX_TASKS];
+    static configRUN_TIME_COUNTER_TYPE last_total = 0;
+    configRUN_TIME_COUNTER_TYPE total;
+
+    UBaseType_t count = uxTaskGetSystemState(status, TRACE_MAX_TASKS, &total);
+    configRUN_TIME_COUNTER_TYPE elapsed = total - last_total;
+
+    last_total = total;
+    if (elapsed == 0) {
+        return;
+    }
+
+    // No SMP o total é o tempo de um núcleo; a soma das tarefas chega a 2000 permil
+    for (UBaseType_t i = 0; i < count; i++) {
+        UBaseType_t number = uxTaskGetTaskNumber(status[i].xHandle);
+        configRUN_TIME_COUNTER_TYPE run_time = status[i].ulRunTimeCounter;
+        configRUN_TIME_COUNTER_TYPE delta = run_time - last_run_time[number];
+
+        last_run_time[number] = run_time;
+        printf("cpu,%u,%s,%lu,%lu\n", (unsigned)number, status[i].pcTaskName,
+               (unsigned long)(delta * 1000 / elapsed), (unsigned long)trace_switches[number]);
+    }
+}
+
+// Envia os registros novos do anel do núcleo em quadros binários. Cada quadro é montado inteiro e sai em
+// uma só escrita (stdio_put_string: sem conversão de fim de linha, sob a trava da saída padrão), então o
+// printf de outra tarefa ou do outro núcleo não cai no meio dele; o agendador segue rodando durante a escrita
+static void trace_stream_ring(uint core, uint32_t *tail) {
+    trace_ring_t *ring = &trace_rings[core];
+    // Estáticos para não pesar na pilha; só a tarefa do rastro chama esta função
+    static trace_record_t chunk[TRACE_FRAME_RECORDS];
+    static uint8_t frame[TRACE_FRAME_HEADER + TRACE_FRAME_RECORDS * sizeof(trace_record_t) + 1];
+
+    for (;;) {
+        uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+        if (head - *tail > TRACE_RING_LENGTH) {
+            printf("trace,%u,dropped,%lu\n", core, (unsigned long)(head - *tail - TRACE_RING_LENGTH));
+            *tail = head - TRACE_RING_LENGTH;
+        }
+
+        uint32_t count = head - *tail;
+        if (count == 0) {
+            return;
+        }
+        if (count > TRACE_FRAME_RECORDS) {
+            count = TRACE_FRAME_RECORDS;
+        }
+
+        for (uint32_t i = 0; i < count; i++) {
+            chunk[i] = ring->records[(*tail + i) % TRACE_RING_LENGTH];
+        }
+
+        // Registros sobrescritos durante a cópia são descartados
+        uint32_t start = *tail;
+        uint32_t new_head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        uint32_t skip = 0;
+        while (skip < count && new_head - (start + skip) > TRACE_RING_LENGTH) {
+            skip++;
+        }
+        *tail = start + count;
+        if (skip == count) {
+            continue;
+        }
+
+        uint32_t length = TRACE_FRAME_HEADER + (count - skip) * sizeof(trace_record_t);
+        uint8_t checksum = 0;
+
+        frame[0] = TRACE_FRAME_MAGIC0;
+        frame[1] = TRACE_FRAME_MAGIC1;
+        frame[2] = (uint8_t)core;
+        frame[3] = (uint8_t)(count - skip);
+        memcpy(&frame[TRACE_FRAME_HEADER], &chunk[skip], (count - skip) * sizeof(trace_record_t));
+
+        // Soma de verificação: o byte final zera a soma (módulo 256) de tudo o que vem depois dos mágicos
+        for (uint32_t i = 2; i < length; i++) {
+            checksum += frame[i];
+        }
+        frame[length++] = (uint8_t)-checksum;
+
+        stdio_put_string((const char *)frame, (int)length, false, false);
+    }
+}
+
+static void trace_stream_task(void *params) {
+    uint32_t tails[configNUMBER_OF_CORES] = {0};
+    TickType_t last_wake = xTaskGetTickCount();
+
+    for (;;) {
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(TRACE_PERIOD_MS));
+
+        trace_print_stats();
+        for (uint core = 0; core < configNUMBER_OF_CORES; core++) {
+            trace_stream_ring(core, &tails[core]);
+        }
+        fflush(stdout);
+    }
+}
+
+void trace_init(UBaseType_t core_mask) {
+    // Prioridade da tarefa ociosa: só roda quando o jogo e o display não têm nada a fazer
+    RTOS_TASK_CREATE(trace_stream, trace_stream_task, "Trace", TRACE_STACK_DEPTH, NULL, tskIDLE_PRIORITY, core_mask);
+}
+
+#endif
@@ -0,0 +1,62 @@
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifndef trace_inc_h
+#define trace_inc_h
+
+// Estatísticas de execução e rastro das trocas de tarefa (cmake -DREFLEX_TRACE=ON).
+// O tempo de CPU de cada tarefa é medido pelo timer de 1 MHz; as trocas de tarefa e as interrupções
+// instrumentadas vão para um anel binário por núcleo. Uma tarefa de prioridade mínima envia tudo pela
+// saída padrão (USB): linhas de texto com o uso de CPU e quadros binários com os registros do anel
+
+#define TRACE_RING_LENGTH       256     // Registros no anel de cada núcleo (potência de 2)
+#define TRACE_MAX_TASKS         16      // Tarefas identificadas (as excedentes dividem o último número)
+#define TRACE_PERIOD_MS         1000    // Intervalo entre os envios
+#define TRACE_FRAME_RECORDS     32      // Registros por quadro binário
+
+// Quadro binário: TRACE_FRAME_MAGIC0, TRACE_FRAME_MAGIC1, núcleo, quantidade, os registros e a soma de
+// verificação (o byte que zera a soma, módulo 256, do núcleo até ele). Os dois bytes mágicos não são ASCII,
+// para separar os quadros do texto do jogo; quadros com soma errada são descartados (tools/trace_decode.py)
+#define TRACE_FRAME_MAGIC0      0xA5
+#define TRACE_FRAME_MAGIC1      0x5A
+#define TRACE_FRAME_HEADER      4       // Bytes antes dos registros
+
+// Tipos de registro
+#define TRACE_EVENT_SWITCH      1       // Tarefa entrou em execução (id = número da tarefa)
+#define TRACE_EVENT_ISR         2       // Entrada de interrupção (id = TRACE_ISR_*)
+
+// Interrupções instrumentadas
+#define TRACE_ISR_GPIO          0       // Bordas dos botões
+
+// Registro do anel (8 bytes, little-endian no quadro): instante em µs (32 bits menos significativos)
+typedef struct {
+    uint32_t timestamp_us;
+    uint8_t type;
+    uint8_t id;
+    uint8_t core;
+    uint8_t reserved;
+} trace_record_t;
+
+#if defined(REFLEX_TRACE) && REFLEX_TRACE
+
+// Cria a tarefa que envia as estatísticas (fixada em core_mask no SMP)
+void trace_init(UBaseType_t core_mask);
+
+// Registra a entrada em uma interrupção; chamada no início do tratador
+void trace_isr_enter(uint8_t irq);
+
+// Ganchos do kernel (FreeRTOSConfig.h)
+void trace_task_switched_in(void);
+uint64_t trace_run_time_us(void);
+
+#define TRACE_ISR(irq) trace_isr_enter(irq)
+
+#else
+
+#define trace_init(core_mask) ((void)(core_mask))
+#define TRACE_ISR(irq) ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,456 @@
+#!/usr/bin/env python3
+"""Converte a fonte e as imagens do display em tabelas C const (na flash), no formato do framebuffer.
+
+Uso:
+    asset_compiler.py font entrada.bdf|entrada.png saida.h [--first 32]
+    asset_compiler.py images saida.h nome=imagem.png [nome=imagem.pbm:rle ...]
+
+Chamado pelo CMake na compilação (alvo assets; os cabeçalhos vão para <build>/generated).
+
+font: gera ssd1306_font.h (usado por inc/ssd1306_i2c.c) a partir de uma fonte BDF ou de uma folha PNG com
+células de 8x8 em linhas de 16, começando no caractere --first. Cada glifo vira 8 colunas de 1 byte (bit 0 em
+cima), e font_index dá o glifo de cada um dos 256 códigos, então ssd1306_draw_char acha o glifo com um só
+acesso, sem comparações; os códigos que a fonte não tem apontam para o espaço.
+
+images: gera um ssd1306_sprite_t (inc/ssd1306_sprite.h) por imagem, em páginas de 8 linhas como o
+framebuffer. Com ":rle", gera um ssd1306_packed_sprite_t comprimido (descomprimido por ssd1306_sprite_unpack);
+bom para imagens grandes e com muito fundo liso. Pixel aceso é o claro (luminância e alfa >= 128) no PNG e o
+1 no PBM (P1 ou P4). O PNG pode ser de qualquer tipo de cor, de 1 a 8 bits, sem entrelaçamento.
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+FONT_WIDTH = 8
+FONT_HEIGHT = 8
+SHEET_COLUMNS = 16
+RLE_MAX_LITERAL = 128
+RLE_MAX_REPEAT = 129
+
+
+class AssetError(Exception):
+    pass
+
+
+# --- Leitura das imagens (matriz de linhas de 0/1, 1 = pixel aceso) ---
+
+def png_unfilter(raw, width, height, bits_per_pixel):
+    stride = (width * bits_per_pixel + 7) // 8
+    step = max(1, bits_per_pixel // 8)
+    rows = []
+    previous = bytearray(stride)
+    offset = 0
+
+    for _ in range(height):
+        kind = raw[offset]
+        line = bytearray(raw[offset + 1:offset + 1 + stride])
+        offset += 1 + stride
+
+        for i in range(stride):
+            left = line[i - step] if i >= step else 0
+            up = previous[i]
+            upper_left = previous[i - step] if i >= step else 0
+            if kind == 1:
+                line[i] = (line[i] + left) & 0xFF
+            elif kind == 2:
+                line[i] = (line[i] + up) & 0xFF
+            elif kind == 3:
+                line[i] = (line[i] + (left + up) // 2) & 0xFF
+            elif kind == 4:
+                p = left + up - upper_left
+                pa, pb, pc = abs(p - left), abs(p - up), abs(p - upper_left)
+                predictor = left if pa <= pb and pa <= pc else up if pb <= pc else upper_left
+                line[i] = (line[i] + predictor) & 0xFF
+            elif kind != 0:
+                raise AssetError(f"filtro PNG desconhecido: {kind}")
+        rows.append(line)
+        previous = line
+    return rows
+
+
+def read_png(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise AssetError(f"{path}: não é PNG")
+
+    offset = 8
+    compressed = b""
+    palette = []
+    transparency = b""
+    header = None
+    while offset < len(data):
+        length, kind = struct.unpack(">I4s", data[offset:offset + 8])
+        chunk = data[offset + 8:offset + 8 + length]
+        offset += 12 + length
+        if kind == b"IHDR":
+            header = struct.unpack(">IIBBBBB", chunk)
+        elif kind == b"PLTE":
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+        elif kind == b"tRNS":
+            transparency = chunk
+        elif kind == b"IDAT":
+            compressed += chunk
+        elif kind == b"IEND":
+            break
+
+    if header is None:
+        raise AssetError(f"{path}: PNG sem IHDR")
+    width, height, depth, color, _, _, interlace = header
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(color)
+    if channels is None or depth > 8 or interlace != 0:
+        raise AssetError(f"{path}: PNG não suportado (cor {color}, {depth} bits, entrelaçamento {interlace})")
+
+    rows = png_unfilter(zlib.decompress(compressed), width, height, depth * channels)
+    maximum = (1 << depth) - 1
+    pixels = []
+    for line in rows:
+        if depth == 8:
+            samples = list(line)
+        else:
+            samples = [(line[(i * depth) // 8] >> (8 - depth - (i * depth) % 8)) & maximum
+                       for i in range(width * channels)]
+
+        out = []
+        for x in range(width):
+            s = samples[x * channels:(x + 1) * channels]
+            alpha = 255
+            if color == 3:
+                r, g, b = palette[s[0]]
+                if s[0] < len(transparency):
+                    alpha = transparency[s[0]]
+            else:
+                s = [v * 255 // maximum for v in s]
+                if color in (0, 4):
+                    r = g = b = s[0]
+                else:
+                    r, g, b = s[0], s[1], s[2]
+                if color in (4, 6):
+                    alpha = s[-1]
+            luminance = (299 * r + 587 * g + 114 * b) // 1000
+            out.append(1 if luminance >= 128 and alpha >= 128 else 0)
+        pixels.append(out)
+    return pixels
+
+
+def read_pbm(path):
+    with open(path, "rb") as f:
+        data = f.read()
+
+    # Cabeçalho: tipo, largura e altura, separados por espaços, com comentários iniciados por '#'
+    tokens = []
+    offset = 0
+    while len(tokens) < 3:
+        while data[offset:offset + 1].isspace():
+            offset += 1
+        if data[offset:offset + 1] == b"#":
+            offset = data.index(b"\n", offset)
+            continue
+        start = offset
+        while not data[offset:offset + 1].isspace():
+            offset += 1
+        tokens.append(data[start:offset].decode())
+    kind, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+
+    if kind == "P1":
+        bits = [int(c) for c in data[offset:].decode() if c in "01"]
+        return [bits[y * width:(y + 1) * width] for y in range(height)]
+    if kind == "P4":
+        body = data[offset + 1:]
+        stride = (width + 7) // 8
+        return [[(body[y * stride + x // 8] >> (7 - x % 8)) & 1 for x in range(width)] for y in range(height)]
+    raise AssetError(f"{path}: PBM não suportado ({kind})")
+
+
+def read_image(path):
+    if path.lower().endswith(".png"):
+        return read_png(path)
+    if path.lower().endswith((".pbm", ".pnm")):
+        return read_pbm(path)
+    raise AssetError(f"{path}: formato não suportado (use PNG ou PBM)")
+
+
+def to_pages(pixels, x0=0, y0=0, width=None, height=None):
+    """Bytes do retângulo em páginas de 8 linhas (bit 0 em cima), cada página da esquerda para a direita."""
+    width = len(pixels[0]) if width is None else width
+    height = len(pixels) if height is None else height
+    out = []
+    for page in range((height + 7) // 8):
+        for x in range(width):
+            value = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < height and pixels[y0 + y][x0 + x]:
+                    value |= 1 << bit
+            out.append(value)
+    return out
+
+
+# --- Fonte ---
+
+def read_bdf(path):
+    """Glifos da fonte BDF: {código: matriz FONT_HEIGHT x FONT_WIDTH}, alinhados pela caixa da fonte."""
+    glyphs = {}
+    box = None
+    code = None
+    bbx = None
+    bitmap = None
+
+    with open(path, encoding="latin-1") as f:
+        for line in f:
+            fields = line.split()
+            if not fields:
+                continue
+            key = fields[0]
+            if key == "FONTBOUNDINGBOX":
+                box = [int(v) for v in fields[1:5]]
+            elif key == "ENCODING":
+                code = int(fields[1])
+            elif key == "BBX":
+                bbx = [int(v) for v in fields[1:5]]
+            elif key == "BITMAP":
+                bitmap = []
+            elif key == "ENDCHAR":
+                if box is None or bbx is None:
+                    raise AssetError(f"{path}: glifo {code} sem FONTBOUNDINGBOX ou BBX")
+                if 0 <= code <= 255:
+                    glyphs[code] = place_bdf_glyph(path, code, box, bbx, bitmap)
+                code, bbx, bitmap = None, None, None
+            elif bitmap is not None:
+                bitmap.append(int(key, 16))
+    return glyphs
+
+
+def place_bdf_glyph(path, code, box, bbx, bitmap):
+    font_w, font_h, font_x, font_y = box
+    w, h, x_off, y_off = bbx
+    if font_w > FONT_WIDTH or font_h > FONT_HEIGHT:
+        raise AssetError(f"{path}: a fonte tem {font_w}x{font_h} pixels; o driver desenha no máximo {FONT_WIDTH}x{FONT_HEIGHT}")
+
+    cell = [[0] * FONT_WIDTH for _ in range(FONT_HEIGHT)]
+    ascent = font_h + font_y                # Linha de base contada do topo da caixa da fonte
+    row_bits = ((w + 7) // 8) * 8
+    for r, value in enumerate(bitmap[:h]):
+        y = ascent - (y_off + h) + r
+        for c in range(w):
+            x = x_off - font_x + c
+            if (value >> (row_bits - 1 - c)) & 1 and 0 <= x < FONT_WIDTH and 0 <= y < FONT_HEIGHT:
+                cell[y][x] = 1
+    return cell
+
+
+def read_font_sheet(path, first):
+    pixels = read_image(path)
+    columns = len(pixels[0]) // FONT_WIDTH
+    rows = len(pixels) // FONT_HEIGHT
+    glyphs = {}
+    for index in range(min(columns, SHEET_COLUMNS) * rows):
+        x0 = (index % SHEET_COLUMNS) * FONT_WIDTH
+        y0 = (index // SHEET_COLUMNS) * FONT_HEIGHT
+        if first + index > 255 or x0 + FONT_WIDTH > len(pixels[0]):
+            continue
+        cell = [row[x0:x0 + FONT_WIDTH] for row in pixels[y0:y0 + FONT_HEIGHT]]
+        if any(any(row) for row in cell) or first + index == 0x20:  # Células vazias não ocupam a flash
+            glyphs[first + index] = cell
+    return glyphs
+
+
+def char_comment(code):
+    if code == 0x20:
+        return "Espaço"
+    if code == 0x5C:
+        return "Barra invertida"        # Uma '\\' no fim do comentário continuaria na linha seguinte
+    if 0x20 < code < 0x7F:
+        return chr(code)
+    return f"0x{code:02X}"
+
+
+def generate_font(glyphs, source):
+    if 0x20 not in glyphs:
+        glyphs[0x20] = [[0] * FONT_WIDTH for _ in range(FONT_HEIGHT)]
+    codes = [0x20] + sorted(c for c in glyphs if c != 0x20)  # O espaço é o glifo 0, usado pelos códigos ausentes
+    if len(codes) > 256:
+        raise AssetError("mais de 256 glifos")
+    index = {code: i for i, code in enumerate(codes)}
+
+    out = []
+    out.append(f"// Gerado por tools/asset_compiler.py a partir de {source}; não editar")
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append("#ifndef ssd1306_font_inc_h")
+    out.append("#define ssd1306_font_inc_h")
+    out.append("")
+    out.append(f"// Fonte de {FONT_WIDTH}x{FONT_HEIGHT} pixels com {len(codes)} glifos. Cada glifo tem {FONT_WIDTH} colunas de 1 byte; o bit 0 é a")
+    out.append("// linha de cima. font_index dá o glifo de cada código de 0 a 255 (os ausentes apontam para o espaço)")
+    out.append(f"#define SSD1306_FONT_FIRST 0x{min(codes):02X}")
+    out.append(f"#define SSD1306_FONT_LAST 0x{max(codes):02X}")
+    out.append(f"#define SSD1306_FONT_WIDTH {FONT_WIDTH}")
+    out.append(f"#define SSD1306_FONT_GLYPHS {len(codes)}")
+    out.append("")
+    out.append("static const uint8_t font_index[256] = {")
+    table = [index.get(code, 0) for code in range(256)]
+    for i in range(0, 256, 16):
+        out.append("    " + ", ".join(f"{v:3d}" for v in table[i:i + 16]) + ",")
+    out.append("};")
+    out.append("")
+    out.append("static const uint8_t font[] = {")
+    for code in codes:
+        columns = to_pages(glyphs[code], width=FONT_WIDTH, height=FONT_HEIGHT)
+        out.append("    " + ", ".join(f"0x{v:02x}" for v in columns) + f", // {char_comment(code)}")
+    out.append("};")
+    out.append("")
+    out.append("#endif")
+    return "\n".join(out) + "\n"
+
+
+# --- Imagens ---
+
+def rle_encode(data):
+    """Byte de controle n < 128: seguem n + 1 bytes literais; n >= 128: o byte seguinte se repete n - 126 vezes."""
+    out = bytearray()
+    literal = bytearray()
+    i = 0
+
+    def flush():
+        for start in range(0, len(literal), RLE_MAX_LITERAL):
+            chunk = literal[start:start + RLE_MAX_LITERAL]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+        literal.clear()
+
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and data[i + run] == data[i] and run < RLE_MAX_REPEAT:
+            run += 1
+        if run >= 2:
+            flush()
+            out.append(run + 126)
+            out.append(data[i])
+            i += run
+        else:
+            literal.append(data[i])
+            i += 1
+    flush()
+    return bytes(out)
+
+
+def rle_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        n = data[i]
+        if n < 128:
+            out.extend(data[i + 1:i + 2 + n])
+            i += 2 + n
+        else:
+            out.extend([data[i + 1]] * (n - 126))
+            i += 2
+    return bytes(out)
+
+
+def c_bytes(values):
+    lines = []
+    for i in range(0, len(values), 16):
+        lines.append("    " + ", ".join(f"0x{v:02x}" for v in values[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def generate_images(specs, guard):
+    out = []
+    out.append("// Gerado por tools/asset_compiler.py; não editar")
+    out.append('#include "ssd1306_sprite.h"')
+    out.append("")
+    out.append(f"#ifndef {guard}")
+    out.append(f"#define {guard}")
+
+    for name, path, packed in specs:
+        pixels = read_image(path)
+        width, height = len(pixels[0]), len(pixels)
+        if width > 255 or height > 255:
+            raise AssetError(f"{path}: {width}x{height} passa de 255 pixels (limite de ssd1306_sprite_t)")
+        data = to_pages(pixels)
+        source = os.path.basename(path)
+
+        out.append("")
+        if packed:
+            encoded = rle_encode(data)
+            assert rle_decode(encoded) == bytes(data)
+            out.append(f"// {source}: {width}x{height}, {len(encoded)} bytes comprimidos ({len(data)} sem compressão)")
+            out.append(f"static const uint8_t {name}_data[] = {{")
+            out.append(c_bytes(encoded))
+            out.append("};")
+            out.append(f"static const ssd1306_packed_sprite_t {name} = {{{width}, {height}, sizeof({name}_data), {name}_data}};")
+        else:
+            out.append(f"// {source}: {width}x{height}, {len(data)} bytes")
+            out.append(f"static const uint8_t {name}_data[] = {{")
+            out.append(c_bytes(data))
+            out.append("};")
+            out.append(f"static const ssd1306_sprite_t {name} = {{{width}, {height}, {name}_data}};")
+
+    out.append("")
+    out.append("#endif")
+    return "\n".join(out) + "\n"
+
+
+def write_if_changed(path, text):
+    directory = os.path.dirname(path)
+    if directory:
+        os.makedirs(directory, exist_ok=True)
+
+    # Só reescreve se mudou, para não recompilar o que inclui o cabeçalho
+    try:
+        with open(path, encoding="utf-8") as f:
+            if f.read() == text:
+                return
+    except FileNotFoundError:
+        pass
+    with open(path, "w", encoding="utf-8") as f:
+        f.write(text)
+
+
+def parse_image_spec(spec):
+    name, sep, path = spec.partition("=")
+    if not sep or not name.isidentifier():
+        raise AssetError(f"imagem inválida: {spec} (use nome=arquivo[:rle])")
+    packed = path.endswith(":rle")
+    if packed:
+        path = path[:-4]
+    return name, path, packed
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    font = commands.add_parser("font")
+    font.add_argument("input")
+    font.add_argument("output")
+    font.add_argument("--first", type=lambda v: int(v, 0), default=0x20, help="primeiro caractere da folha PNG")
+
+    images = commands.add_parser("images")
+    images.add_argument("output")
+    images.add_argument("images", nargs="+", metavar="nome=arquivo[:rle]")
+
+    args = parser.parse_args()
+    try:
+        if args.command == "font":
+            if args.input.lower().endswith(".bdf"):
+                glyphs = read_bdf(args.input)
+            else:
+                glyphs = read_font_sheet(args.input, args.first)
+            text = generate_font(glyphs, os.path.basename(args.input))
+        else:
+            guard = os.path.splitext(os.path.basename(args.output))[0] + "_inc_h"
+            text = generate_images([parse_image_spec(s) for s in args.images], guard)
+    except (AssetError, OSError, ValueError, zlib.error) as error:
+        print(f"asset_compiler: {error}", file=sys.stderr)
+        sys.exit(1)
+
+    write_if_changed(args.output, text)
+
+
+if __name__ == "__main__":
+    main()
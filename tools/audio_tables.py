@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""Gera as tabelas do sintetizador dos buzzers (src/audio.c) em C, só com inteiros.
+
+Uso:
+    audio_tables.py saida/audio_tables.h [--rate 32000]
+
+Chamado pelo CMake na compilação (o cabeçalho vai para <build>/generated). Gera:
+  - as formas de onda (AUDIO_WAVE_*), AUDIO_WAVE_LENGTH amostras de -127 a 127 cada;
+  - o incremento de fase (Q32) de cada nota MIDI na taxa de amostragem, para audio_play_note;
+  - AUDIO_PHASE_PER_HZ, que converte uma frequência em Hz no incremento de fase com uma multiplicação;
+  - a curva de volume: AUDIO_VOLUME_STEPS ganhos de 0 a 255 em passos iguais de dB.
+"""
+
+import argparse
+import math
+import os
+
+WAVE_LENGTH = 256
+VOLUME_STEPS = 16
+VOLUME_STEP_DB = 2.5
+PWM_WRAP = 255
+
+# Formas de onda: (nome, amplitudes dos harmônicos 1..n). A quadrada é gerada direto, sem harmônicos
+WAVES = [
+    ("SQUARE", None),
+    ("TRIANGLE", [1.0, 0, -1 / 9, 0, 1 / 25, 0, -1 / 49]),
+    ("SINE", [1.0]),
+    ("ORGAN", [1.0, 0.5, 0.25, 0, 0.125]),
+]
+
+
+def wave_samples(harmonics):
+    if harmonics is None:
+        return [100 if i < WAVE_LENGTH // 2 else -100 for i in range(WAVE_LENGTH)]
+
+    values = []
+    for i in range(WAVE_LENGTH):
+        t = 2 * math.pi * i / WAVE_LENGTH
+        values.append(sum(a * math.sin((n + 1) * t) for n, a in enumerate(harmonics)))
+    peak = max(abs(v) for v in values)
+    return [round(v / peak * 127) for v in values]
+
+
+def midi_frequency(note):
+    return 440.0 * 2 ** ((note - 69) / 12)
+
+
+def phase_increment(frequency, rate):
+    return min(round(frequency / rate * 2 ** 32), 2 ** 31 - 1)  # No máximo meia volta por amostra (Nyquist)
+
+
+def volume_gain(step):
+    if step == 0:
+        return 0
+    return round(255 * 10 ** (-(VOLUME_STEPS - 1 - step) * VOLUME_STEP_DB / 20))
+
+
+def define(name, value, comment=None):
+    line = f"#define {name:<23} {value}"
+    return f"{line:<40}// {comment}" if comment else line
+
+
+def rows(values, per_row, width):
+    text = []
+    for i in range(0, len(values), per_row):
+        text.append("    " + ", ".join(f"{v:{width}d}" for v in values[i:i + per_row]) + ",")
+    return "\n".join(text)
+
+
+def generate(rate):
+    out = []
+    out.append("// Gerado por tools/audio_tables.py na compilação; não editar")
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append("#ifndef audio_tables_inc_h")
+    out.append("#define audio_tables_inc_h")
+    out.append("")
+    out.append(define("AUDIO_SAMPLE_RATE", rate, "Amostras por segundo de cada buzzer"))
+    out.append(define("AUDIO_PWM_WRAP", PWM_WRAP, "Topo do PWM: amostras de 8 bits"))
+    out.append(define("AUDIO_WAVE_LENGTH", WAVE_LENGTH, "Amostras por período (índice = 8 bits altos da fase)"))
+    out.append(define("AUDIO_PHASE_PER_HZ", f"{round(2 ** 32 / rate)}u", "Incremento de fase (Q32) por Hz"))
+    out.append(define("AUDIO_VOLUME_STEPS", VOLUME_STEPS))
+    out.append(define("AUDIO_MIDI_NOTES", 128))
+    out.append("")
+    for index, (name, _) in enumerate(WAVES):
+        out.append(define(f"AUDIO_WAVE_{name}", index))
+    out.append(define("AUDIO_NUM_WAVES", len(WAVES)))
+    out.append("")
+    out.append("// Formas de onda (const: ficam na flash)")
+    out.append("static const int8_t audio_waves[AUDIO_NUM_WAVES][AUDIO_WAVE_LENGTH] = {")
+    for name, harmonics in WAVES:
+        out.append(f"    // {name}")
+        out.append("    {")
+        out.append(rows(wave_samples(harmonics), 16, 4).replace("    ", "        ", 1).replace("\n    ", "\n        "))
+        out.append("    },")
+    out.append("};")
+    out.append("")
+    out.append(f"// Incremento de fase de cada nota MIDI (69 = lá 440 Hz) a {rate} amostras/s")
+    out.append("static const uint32_t audio_pitch_table[AUDIO_MIDI_NOTES] = {")
+    out.append(rows([phase_increment(midi_frequency(n), rate) for n in range(128)], 8, 10))
+    out.append("};")
+    out.append("")
+    step_db = f"{VOLUME_STEP_DB:g}".replace(".", ",")
+    out.append(f"// Ganho (0..255) de cada passo de volume, {step_db} dB por passo; o passo 0 é silêncio")
+    out.append("static const uint8_t audio_volume_table[AUDIO_VOLUME_STEPS] = {")
+    out.append(rows([volume_gain(s) for s in range(VOLUME_STEPS)], 16, 3))
+    out.append("};")
+    out.append("")
+    out.append("#endif")
+    return "\n".join(out) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("output")
+    parser.add_argument("--rate", type=int, default=32000)
+    args = parser.parse_args()
+
+    text = generate(args.rate)
+    directory = os.path.dirname(args.output)
+    if directory:
+        os.makedirs(directory, exist_ok=True)
+
+    # Só reescreve se mudou, para não recompilar o que inclui o cabeçalho
+    try:
+        with open(args.output, encoding="utf-8") as f:
+            if f.read() == text:
+                return
+    except FileNotFoundError:
+        pass
+    with open(args.output, "w", encoding="utf-8") as f:
+        f.write(text)
+
+
+if __name__ == "__main__":
+    main()
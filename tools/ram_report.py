@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""Relatório de uso de RAM a partir do mapa do ligador (<projeto>.elf.map).
+
+Uso:
+    ram_report.py firmware.elf.map              # RAM por seção e maiores símbolos
+    ram_report.py padrao.elf.map estatico.elf.map  # compara dois perfis (ex.: heap_4 x REFLEX_STATIC_ALLOC)
+
+Conta as seções de entrada alocadas na SRAM do RP2040 (0x20000000..0x20042000). O heap do
+FreeRTOS aparece como o símbolo ucHeap (heap_4); o heap da libc aparece na seção .heap.
+"""
+
+import re
+import sys
+from collections import defaultdict
+
+RAM_START = 0x20000000
+RAM_END = 0x20042000
+TOP = 15
+
+# Linha de seção de entrada: " .bss.nome  0xendereço  0xtamanho  arquivo". Nomes longos
+# deixam o endereço e o tamanho na linha seguinte
+SECTION = re.compile(r"^ (\.[^\s]+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(.*))?$")
+CONTINUATION = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(.*)$")
+
+
+def read_map(path):
+    """Devolve {seção de entrada: bytes} com tudo o que ocupa RAM."""
+    usage = defaultdict(int)
+    pending = None
+
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            line = line.rstrip("\n")
+            if pending is not None:
+                m = CONTINUATION.match(line)
+                if m:
+                    add(usage, pending, int(m.group(1), 16), int(m.group(2), 16), m.group(3))
+                pending = None
+                continue
+
+            m = SECTION.match(line)
+            if not m:
+                continue
+            if m.group(2) is None:
+                pending = m.group(1)
+            else:
+                add(usage, m.group(1), int(m.group(2), 16), int(m.group(3), 16), m.group(4))
+
+    return usage
+
+
+def add(usage, name, address, size, source):
+    if size == 0 or not (RAM_START <= address < RAM_END):
+        return
+    obj = source.strip().split("/")[-1]
+    usage[f"{name} ({obj})"] += size
+
+
+def group(usage):
+    """Soma por seção de saída (.data, .bss, .heap, ...)."""
+    totals = defaultdict(int)
+    for key, size in usage.items():
+        name = key.split(" ")[0]
+        out = "." + name.split(".")[1] if name.count(".") > 1 else name
+        totals[out] += size
+    return totals
+
+
+def report(path):
+    usage = read_map(path)
+    total = sum(usage.values())
+
+    print(f"# {path}")
+    print(f"RAM total: {total} bytes ({total / 1024:.1f} KiB de {(RAM_END - RAM_START) // 1024} KiB)")
+    for name, size in sorted(group(usage).items(), key=lambda kv: -kv[1]):
+        print(f"  {name:<24} {size:>8}")
+
+    print(f"Maiores {TOP} símbolos:")
+    for key, size in sorted(usage.items(), key=lambda kv: -kv[1])[:TOP]:
+        print(f"  {size:>8}  {key}")
+
+    return usage
+
+
+def compare(base_path, new_path):
+    base = report(base_path)
+    print()
+    new = report(new_path)
+    print()
+
+    base_total = sum(base.values())
+    new_total = sum(new.values())
+    print(f"Diferença: {new_total - base_total:+d} bytes ({base_total - new_total} bytes recuperados)")
+
+    diff = [(new.get(k, 0) - base.get(k, 0), k) for k in set(base) | set(new)]
+    diff = [d for d in diff if d[0] != 0]
+    for delta, key in sorted(diff, key=lambda d: -abs(d[0]))[:TOP]:
+        print(f"  {delta:>+8}  {key}")
+
+
+def main(argv):
+    if len(argv) == 2:
+        report(argv[1])
+    elif len(argv) == 3:
+        compare(argv[1], argv[2])
+    else:
+        print(__doc__)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
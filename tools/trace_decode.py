@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+"""Separa e decodifica a saída do firmware compilado com REFLEX_TRACE.
+
+Uso:
+    trace_decode.py captura.bin          # arquivo gravado da porta serial USB
+    trace_decode.py /dev/ttyACM0         # leitura direta da porta (Ctrl+C para sair)
+
+As linhas de texto (jogo e uso de CPU "cpu,<número>,<nome>,<permil>,<trocas>") são repassadas;
+os quadros binários do anel (src/trace.h) viram uma linha por registro:
+    <µs> core<n> switch <tarefa>
+    <µs> core<n> isr <interrupção>
+"""
+
+import struct
+import sys
+
+MAGIC = b"\xa5\x5a"
+HEADER = 4  # TRACE_FRAME_HEADER
+MAX_RECORDS = 32  # TRACE_FRAME_RECORDS
+RECORD = struct.Struct("<IBBBB")  # trace_record_t
+EVENT_SWITCH = 1
+EVENT_ISR = 2
+ISR_NAMES = {0: "gpio"}
+
+
+def decode(stream):
+    data = b""
+    tasks = {}
+
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            break
+        data += chunk
+
+        while True:
+            start = data.find(MAGIC)
+            text_end = start if start >= 0 else len(data)
+            newline = data.rfind(b"\n", 0, text_end)
+            if newline >= 0:
+                for line in data[:newline + 1].decode("utf-8", "replace").splitlines():
+                    emit_text(line.rstrip("\r"), tasks)
+                data = data[newline + 1:]
+                continue
+            if start < 0 or len(data) < start + HEADER:
+                break
+
+            count = data[start + 3]
+            if count == 0 or count > MAX_RECORDS:
+                data = reject(data, start)
+                continue
+            end = start + HEADER + count * RECORD.size + 1
+            if len(data) < end:
+                break
+
+            # Soma de verificação do núcleo até o último byte: quadro corrompido vira texto a partir do
+            # byte seguinte aos mágicos, procurando o próximo quadro
+            if sum(data[start + 2:end]) & 0xFF:
+                data = reject(data, start)
+                continue
+
+            core = data[start + 2]
+            for i in range(count):
+                timestamp, kind, ident, _, _ = RECORD.unpack_from(data, start + HEADER + i * RECORD.size)
+                if kind == EVENT_SWITCH:
+                    print(f"{timestamp} core{core} switch {tasks.get(ident, ident)}")
+                elif kind == EVENT_ISR:
+                    print(f"{timestamp} core{core} isr {ISR_NAMES.get(ident, ident)}")
+            data = data[:start] + data[end:]
+
+
+def reject(data, start):
+    print("trace: quadro inválido descartado", file=sys.stderr)
+    return data[:start] + data[start + len(MAGIC):]
+
+
+def emit_text(line, tasks):
+    # As linhas de uso de CPU dão o nome de cada número de tarefa
+    fields = line.split(",")
+    if len(fields) == 5 and fields[0] == "cpu" and fields[1].isdigit():
+        tasks[int(fields[1])] = fields[2]
+    print(line)
+
+
+def main(argv):
+    if len(argv) != 2:
+        print(__doc__)
+        return 1
+    try:
+        with open(argv[1], "rb", buffering=0) as stream:
+            decode(stream)
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))